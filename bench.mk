@@ -0,0 +1,61 @@
+BENCH_DIR = bench
+BENCH_BIN_DIR = bench_bin
+BENCH_OBJECTS_DIR = bench_objects
+BENCH_EXECUTABLE = $(BENCH_BIN_DIR)/bench_runner
+BENCH_SOURCES = $(wildcard $(BENCH_DIR)/*.cpp)
+BENCH_OBJECTS = $(patsubst $(BENCH_DIR)/%.cpp, $(BENCH_OBJECTS_DIR)/%.o, $(BENCH_SOURCES))
+BENCH_JSON ?= $(BENCH_BIN_DIR)/bench.json
+BENCH_ARGS ?=
+# percentage a benchmark may be slower than its baseline before bench_compare fails
+BENCH_TOLERANCE ?= 10
+BENCH_CXX = g++
+# same optimisation flags as the plugin build, so the numbers match what ships
+BENCH_CXXFLAGS = -std=c++11 -Wall -Wextra -Wno-unused-parameter $(ARCH_FLAG)
+BENCH_CXXFLAGS += -O3 -funsafe-math-optimizations -fno-omit-frame-pointer
+ifeq ($(ARCH_CPU), x64)
+	BENCH_CXXFLAGS += -march=nehalem
+endif
+ifeq ($(ARCH_CPU), arm64)
+	BENCH_CXXFLAGS += -march=armv8-a+fp+simd
+endif
+BENCH_INCLUDE_DIRS = $(TEST_INCLUDE_DIRS)
+BENCH_LDFLAGS = $(TEST_LDFLAGS)
+
+.PHONY: bench bench_compare bench_baseline clean_bench
+
+$(BENCH_EXECUTABLE): $(BENCH_OBJECTS)
+	@mkdir -p $(@D)
+	$(BENCH_CXX) $(BENCH_CXXFLAGS) $^ $(BENCH_LDFLAGS) -o $@
+ifeq ($(ARCH_OS), mac)
+	install_name_tool -change libRack.dylib $(RACK_DIR)/libRack.dylib $@
+endif
+
+$(BENCH_OBJECTS_DIR)/%.o: $(BENCH_DIR)/%.cpp
+	@mkdir -p $(@D)
+	$(BENCH_CXX) $(BENCH_CXXFLAGS) $(BENCH_INCLUDE_DIRS) -c $< -o $@
+
+ifeq ($(ARCH_OS), mac)
+	BENCH_RUN = ./$(BENCH_EXECUTABLE) --json $(BENCH_JSON)
+else
+	BENCH_RUN = export PATH=$(RACK_APP_DIR):$$PATH; ./$(BENCH_EXECUTABLE) --json $(BENCH_JSON)
+endif
+
+bench: clean_bench $(BENCH_EXECUTABLE)
+	@echo "Running DanT benchmarks..."
+	@$(BENCH_RUN) $(BENCH_ARGS)
+
+# fails if any benchmark is slower than the baseline for this CPU by more than BENCH_TOLERANCE percent
+bench_compare: clean_bench $(BENCH_EXECUTABLE)
+	@echo "Comparing DanT benchmarks against the baseline..."
+	@$(BENCH_RUN) --compare --tolerance $(BENCH_TOLERANCE) $(BENCH_ARGS)
+
+# records the baseline for this CPU in bench/baselines
+bench_baseline: clean_bench $(BENCH_EXECUTABLE)
+	@echo "Recording the DanT benchmark baseline..."
+	@mkdir -p bench/baselines
+	@$(BENCH_RUN) --save-baseline $(BENCH_ARGS)
+
+clean_bench:
+	@echo "Cleaning benchmark artifacts..."
+	rm -rf $(BENCH_BIN_DIR)
+	rm -rf $(BENCH_OBJECTS_DIR)
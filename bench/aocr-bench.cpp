@@ -0,0 +1,74 @@
+#include "../src/modules/aocr.cpp"
+
+#include <memory>
+#include <rack.hpp>
+#include <string>
+
+#include "../tests/module-harness.hpp"
+#include "bench.hpp"
+
+namespace {
+
+const int READER_THREADS{2};
+
+// full module process, input voltages are written straight into the port so only process() is timed
+// with numReaders, threads poll the module's snapshots throughout, like the UI of a busy patch
+// with eco, the plugin wide Eco mode setting is on while the benchmark runs
+void addAocrProcess(const std::string& setting, const int numChannels, const bool processed,
+                    const int numReaders = 0, const bool eco = false) {
+  std::shared_ptr<DANT::ModuleHarness<AocrModule>> harness{new DANT::ModuleHarness<AocrModule>()};
+  harness->module.inputs[AocrModule::SGNL_INPUT].channels = numChannels;
+  if (processed) {
+    harness->setParam(AocrModule::ORDER_PARAM, DANT::OP_ORDER::CROA);
+    harness->setParam(AocrModule::ATV_PARAM, -1.5f);
+    harness->setParam(AocrModule::OFS_PARAM, 2.0f);
+    harness->setParam(AocrModule::CLIP_PARAM, DANT::CLIP_LVL::FIVE_CLIP);
+    harness->setParam(AocrModule::RECT_PARAM, DANT::RECT_LVL::FULL_RECT);
+  }
+
+  DANT::Bench::Benchmark benchmark;
+  benchmark.name = "module/aocr/" + setting + "/" + std::to_string(numChannels) + "ch";
+  benchmark.group = "module/aocr";
+  benchmark.params = {{"setting", setting}, {"channels", std::to_string(numChannels)}};
+  benchmark.channels = numChannels;
+  benchmark.run = [harness, numChannels](const int numFrames) {
+    float* voltages = harness->module.inputs[AocrModule::SGNL_INPUT].voltages;
+    for (int i{0}; i < numFrames; ++i) {
+      for (int c{0}; c < numChannels; ++c) {
+        voltages[c] = -12.0f + static_cast<float>((i + c) & 63) * 0.375f;
+      }
+      harness->step();
+    }
+    DANT::Bench::keep(harness->getOutput(AocrModule::SGNL_OUTPUT));
+  };
+  if (numReaders > 0) {
+    std::shared_ptr<DANT::Bench::Readers> readers{std::make_shared<DANT::Bench::Readers>()};
+    benchmark.setUp = [harness, readers, numReaders]() {
+      readers->start(numReaders, [harness]() {
+        DANT::Bench::keep(harness->module.inputGridSnapshot.read());
+        DANT::Bench::keep(harness->module.outputGridSnapshot.read());
+        DANT::Bench::keep(harness->module.cvSnapshot.read());
+      });
+    };
+    benchmark.tearDown = [readers]() { readers->stop(); };
+  }
+  if (eco) {
+    benchmark.setUp = []() { DANT::ECO_MODE.store(true); };
+    benchmark.tearDown = []() { DANT::ECO_MODE.store(DANT::DEFAULT_ECO_MODE); };
+  }
+  DANT::Bench::add(benchmark);
+}
+
+}  // namespace
+
+void DANT::Bench::addAocrBenchmarks() {
+  for (const int numChannels : {1, 4, 8, 16}) {
+    addAocrProcess("default", numChannels, false);
+    addAocrProcess("croa", numChannels, true);
+    addAocrProcess("eco", numChannels, true, 0, true);
+  }
+  // contended timings only mean something with a core per thread
+  if (DANT::Bench::Readers::hasSpareCores(READER_THREADS)) {
+    addAocrProcess("readers", 16, true, READER_THREADS);
+  }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>  // std::max
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <rack.hpp>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace DANT {
+namespace Bench {
+
+/**
+ * Baselines are benchmark JSON files committed under bench/baselines, one per CPU model.
+ * Timings are only comparable on the CPU they were recorded on, so a run only compares against its own CPU's file.
+ */
+static const char* const BASELINE_DIR{"bench/baselines"};
+static const double DEFAULT_TOLERANCE_PERCENT{10.0};
+
+// file name for a CPU model, e.g. "Intel(R) Core(TM) i7-9750H CPU @ 2.60GHz" -> "intel-r-core-tm-i7-9750h-cpu-2-60ghz"
+inline std::string cpuSlug(const std::string& model) {
+  std::string slug;
+  for (const char ch : model) {
+    if (std::isalnum(static_cast<unsigned char>(ch))) {
+      slug += static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    } else if (!slug.empty() && slug.back() != '-') {
+      slug += '-';
+    }
+  }
+  while (!slug.empty() && slug.back() == '-') {
+    slug.pop_back();
+  }
+  return slug.empty() ? "unknown" : slug;
+}
+
+inline std::string baselineFile(const std::string& dir, const std::string& model) {
+  return dir + "/" + cpuSlug(model) + ".json";
+}
+
+// baseline median ns per sample-channel, by benchmark name
+typedef std::map<std::string, double> Baseline;
+
+inline bool loadBaseline(const std::string& file, Baseline& baseline) {
+  json_error_t error;
+  json_t* rootJ = json_load_file(file.c_str(), 0, &error);
+  if (!rootJ) {
+    return false;
+  }
+  json_t* resultsJ = json_object_get(rootJ, "results");
+  size_t i;
+  json_t* resultJ;
+  json_array_foreach(resultsJ, i, resultJ) {
+    json_t* nameJ = json_object_get(resultJ, "name");
+    json_t* nsJ = json_object_get(resultJ, "ns_per_sample_channel");
+    if (json_is_string(nameJ) && json_is_number(nsJ)) {
+      baseline[json_string_value(nameJ)] = json_number_value(nsJ);
+    }
+  }
+  json_decref(rootJ);
+  return true;
+}
+
+struct Comparison {
+  const Result* result;
+  double baselineNs;
+  double changePercent;  // positive is slower than the baseline
+  bool regressed;        // slower by more than the tolerance
+};
+
+inline double changePercent(const double baselineNs, const double currentNs) {
+  return baselineNs > 0.0 ? ((currentNs / baselineNs) - 1.0) * 100.0 : 0.0;
+}
+
+// returns false when the benchmark has no baseline, e.g. it was added after the baseline was recorded
+inline bool compare(const Result& result, const Baseline& baseline, const double tolerancePercent,
+                    Comparison& comparison) {
+  const auto found = baseline.find(result.benchmark->name);
+  if (found == baseline.end()) {
+    return false;
+  }
+  comparison.result = &result;
+  comparison.baselineNs = found->second;
+  comparison.changePercent = changePercent(found->second, result.nsPerSampleChannel);
+  comparison.regressed = comparison.changePercent > tolerancePercent;
+  return true;
+}
+
+/**
+ * Change summary for a group of comparisons, e.g. every kernel of one OP_ORDER.
+ * The mean is the geometric mean of the current/baseline ratios, so a 2x slowdown and a 2x speedup cancel out.
+ */
+struct GroupChange {
+  std::string label;
+  int count{0};
+  int regressions{0};
+  double meanChangePercent{0.0};
+  double worstChangePercent{0.0};
+};
+
+// groups comparisons by label in first seen order, comparisons with an empty label are left out
+inline std::vector<GroupChange> groupChanges(const std::vector<Comparison>& comparisons,
+                                             const std::function<std::string(const Result&)>& labelFor) {
+  std::vector<GroupChange> groups;
+  std::vector<double> logRatioSums;
+  std::map<std::string, size_t> indices;
+  for (const Comparison& comparison : comparisons) {
+    const std::string label{labelFor(*comparison.result)};
+    if (label.empty()) {
+      continue;
+    }
+    if (indices.find(label) == indices.end()) {
+      indices[label] = groups.size();
+      groups.push_back(GroupChange{});
+      groups.back().label = label;
+      groups.back().worstChangePercent = comparison.changePercent;
+      logRatioSums.push_back(0.0);
+    }
+    const size_t index{indices[label]};
+    GroupChange& group = groups[index];
+    ++group.count;
+    group.regressions += comparison.regressed ? 1 : 0;
+    group.worstChangePercent = std::max(group.worstChangePercent, comparison.changePercent);
+    logRatioSums[index] += std::log1p(comparison.changePercent / 100.0);
+  }
+  for (size_t g{0}; g < groups.size(); ++g) {
+    groups[g].meanChangePercent = std::expm1(logRatioSums[g] / groups[g].count) * 100.0;
+  }
+  return groups;
+}
+
+// value of a benchmark param, empty if the benchmark doesn't have it
+inline std::string param(const Result& result, const std::string& name) {
+  for (const auto& p : result.benchmark->params) {
+    if (p.first == name) {
+      return p.second;
+    }
+  }
+  return "";
+}
+
+}  // namespace Bench
+}  // namespace DANT
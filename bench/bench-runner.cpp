@@ -0,0 +1,250 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <rack.hpp>
+#include <string>
+#include <vector>
+
+#include "baseline.hpp"
+#include "bench.hpp"
+
+// the plugin globals the modules link against
+#include "../src/plugin.cpp"
+
+/**
+ * Runs the DanT benchmarks and reports ns per sample-channel.
+ * Usage: bench_runner [--filter text] [--frames n] [--repeats n] [--json file]
+ *                     [--compare] [--baseline file] [--tolerance percent] [--save-baseline] [--counters]
+ * --compare checks the results against the baseline for this CPU, and fails if any benchmark is slower than its
+ * baseline by more than the tolerance. --baseline compares against a specific file instead.
+ * --save-baseline records the results as the baseline for this CPU.
+ * --counters also reports hardware counters per benchmark, IPC and misses per sample-channel, Linux only.
+ */
+struct Options {
+  std::string filter;
+  int frames{48000};
+  int repeats{7};
+  std::string jsonFile;
+  bool compare{false};
+  std::string baselineFile;
+  double tolerancePercent{DANT::Bench::DEFAULT_TOLERANCE_PERCENT};
+  bool saveBaseline{false};
+  bool counters{false};
+};
+
+static const char* USAGE{
+    "usage: %s [--filter text] [--frames n] [--repeats n] [--json file]\n"
+    "       [--compare] [--baseline file] [--tolerance percent] [--save-baseline] [--counters]\n"};
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i{1}; i < argc; ++i) {
+    const bool hasValue{i + 1 < argc};
+    if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+      options.filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+      options.frames = std::max(64, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--repeats") == 0 && hasValue) {
+      options.repeats = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+      options.jsonFile = argv[++i];
+    } else if (std::strcmp(argv[i], "--compare") == 0) {
+      options.compare = true;
+    } else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue) {
+      options.compare = true;
+      options.baselineFile = argv[++i];
+    } else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue) {
+      options.tolerancePercent = std::max(0.0, std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--save-baseline") == 0) {
+      options.saveBaseline = true;
+    } else if (std::strcmp(argv[i], "--counters") == 0) {
+      options.counters = true;
+    } else {
+      std::fprintf(stderr, USAGE, argv[0]);
+      return false;
+    }
+  }
+  if (options.saveBaseline && !options.filter.empty()) {
+    std::fprintf(stderr, "--save-baseline records every benchmark, it can't be used with --filter\n");
+    return false;
+  }
+  return true;
+}
+
+// raw counts for the counted run, plus IPC and counts per sample-channel
+static json_t* countersToJson(const DANT::Bench::Result& result) {
+  const int64_t sampleChannels{result.samples * result.benchmark->channels};
+  json_t* countersJ = json_object();
+  for (int c{0}; c < DANT::Bench::NUM_PERF_COUNTERS; ++c) {
+    if (!result.counters.available[c]) {
+      continue;
+    }
+    const DANT::Bench::PERF_COUNTER counter{static_cast<DANT::Bench::PERF_COUNTER>(c)};
+    json_object_set_new(countersJ, DANT::Bench::PERF_COUNTER_NAMES[c], json_integer(result.counters.values[c]));
+    json_object_set_new(countersJ, (std::string(DANT::Bench::PERF_COUNTER_NAMES[c]) + "_per_sample_channel").c_str(),
+                        json_real(result.counters.perSample(counter, sampleChannels)));
+  }
+  json_object_set_new(countersJ, "ipc", json_real(result.counters.ipc()));
+  return countersJ;
+}
+
+static void printCounters(const DANT::Bench::Result& result) {
+  const int64_t sampleChannels{result.samples * result.benchmark->channels};
+  const DANT::Bench::PerfCounts& counts = result.counters;
+  std::printf(" %6.2f", counts.ipc());
+  for (const DANT::Bench::PERF_COUNTER counter :
+       {DANT::Bench::BRANCH_MISSES_COUNTER, DANT::Bench::L1D_MISSES_COUNTER}) {
+    if (counts.available[counter]) {
+      std::printf(" %12.4f", counts.perSample(counter, sampleChannels));
+    } else {
+      std::printf(" %12s", "-");
+    }
+  }
+}
+
+static json_t* resultsToJson(const std::vector<DANT::Bench::Result>& results, const Options& options) {
+  json_t* rootJ = json_object();
+  json_object_set_new(rootJ, "cpu", json_string(DANT::Bench::cpuModel().c_str()));
+  json_object_set_new(rootJ, "compiler", json_string(__VERSION__));
+  json_object_set_new(rootJ, "frames", json_integer(options.frames));
+  json_object_set_new(rootJ, "repeats", json_integer(options.repeats));
+  json_t* resultsJ = json_array();
+  for (const DANT::Bench::Result& result : results) {
+    json_t* resultJ = json_object();
+    json_object_set_new(resultJ, "name", json_string(result.benchmark->name.c_str()));
+    json_object_set_new(resultJ, "group", json_string(result.benchmark->group.c_str()));
+    json_t* paramsJ = json_object();
+    for (const auto& param : result.benchmark->params) {
+      json_object_set_new(paramsJ, param.first.c_str(), json_string(param.second.c_str()));
+    }
+    json_object_set_new(resultJ, "params", paramsJ);
+    json_object_set_new(resultJ, "channels", json_integer(result.benchmark->channels));
+    json_object_set_new(resultJ, "ns_per_sample_channel", json_real(result.nsPerSampleChannel));
+    json_object_set_new(resultJ, "min_ns_per_sample_channel", json_real(result.minNsPerSampleChannel));
+    if (result.counters.any()) {
+      json_object_set_new(resultJ, "counters", countersToJson(result));
+    }
+    json_array_append_new(resultsJ, resultJ);
+  }
+  json_object_set_new(rootJ, "results", resultsJ);
+  return rootJ;
+}
+
+static bool writeJson(const std::vector<DANT::Bench::Result>& results, const Options& options,
+                      const std::string& file) {
+  json_t* rootJ = resultsToJson(results, options);
+  const int saved{json_dump_file(rootJ, file.c_str(), JSON_INDENT(2) | JSON_REAL_PRECISION(6))};
+  json_decref(rootJ);
+  if (saved != 0) {
+    std::fprintf(stderr, "could not write %s\n", file.c_str());
+    return false;
+  }
+  std::printf("results written to %s\n", file.c_str());
+  return true;
+}
+
+static void printGroupChanges(const char* title, const std::vector<DANT::Bench::GroupChange>& groups) {
+  if (groups.empty()) {
+    return;
+  }
+  std::printf("\n%-32s %8s %12s %12s %12s\n", title, "count", "mean", "worst", "regressions");
+  for (const DANT::Bench::GroupChange& group : groups) {
+    std::printf("%-32s %8d %+11.1f%% %+11.1f%% %12d\n", group.label.c_str(), group.count, group.meanChangePercent,
+                group.worstChangePercent, group.regressions);
+  }
+}
+
+// prints the diff tables and returns the number of regressions
+static int reportComparisons(const std::vector<DANT::Bench::Comparison>& comparisons, const size_t numResults,
+                             const Options& options) {
+  int regressions{0};
+  for (const DANT::Bench::Comparison& comparison : comparisons) {
+    regressions += comparison.regressed ? 1 : 0;
+  }
+  printGroupChanges("by OP_ORDER", DANT::Bench::groupChanges(comparisons, [](const DANT::Bench::Result& result) {
+                      return DANT::Bench::param(result, "order");
+                    }));
+  // kernels always run one 4 channel block, so only the modules are grouped by channel count
+  printGroupChanges("by channel count", DANT::Bench::groupChanges(comparisons, [](const DANT::Bench::Result& result) {
+                      return result.benchmark->group.compare(0, 7, "module/") == 0
+                                 ? result.benchmark->group + " " + std::to_string(result.benchmark->channels) + "ch"
+                                 : std::string("");
+                    }));
+  std::printf("\n%d of %d benchmarks compared, %d without a baseline, %d slower than the %.1f%% tolerance\n",
+              static_cast<int>(comparisons.size()), static_cast<int>(numResults),
+              static_cast<int>(numResults - comparisons.size()), regressions, options.tolerancePercent);
+  return regressions;
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    return 2;
+  }
+
+  DANT::Bench::addDspBenchmarks();
+  DANT::Bench::addAocrBenchmarks();
+  DANT::Bench::addBendBenchmarks();
+
+  const std::string cpu{DANT::Bench::cpuModel()};
+  const std::string cpuBaselineFile{DANT::Bench::baselineFile(DANT::Bench::BASELINE_DIR, cpu)};
+  DANT::Bench::Baseline baseline;
+  bool comparing{false};
+  if (options.compare) {
+    const std::string file{options.baselineFile.empty() ? cpuBaselineFile : options.baselineFile};
+    comparing = DANT::Bench::loadBaseline(file, baseline);
+    if (comparing) {
+      std::printf("comparing against %s, tolerance %.1f%%\n", file.c_str(), options.tolerancePercent);
+    } else {
+      // no baseline for this CPU is not a failure, there is nothing to compare against
+      std::printf("no baseline %s, record one with --save-baseline\n", file.c_str());
+    }
+  }
+
+  DANT::Bench::PerfCounters perfCounters;
+  const bool counting{options.counters && perfCounters.isAvailable()};
+  if (options.counters && !counting) {
+    std::printf("hardware counters are not available, on Linux check /proc/sys/kernel/perf_event_paranoid\n");
+  }
+
+  std::printf("DanT benchmarks, %s\n", cpu.c_str());
+  std::printf("%-48s %14s %14s", "benchmark", "ns/sample-ch", "min");
+  if (counting) {
+    std::printf(" %6s %12s %12s", "IPC", "br-miss/s-ch", "L1-miss/s-ch");
+  }
+  std::printf(comparing ? " %14s %10s\n" : "\n", "baseline", "change");
+  std::vector<DANT::Bench::Result> results;
+  results.reserve(DANT::Bench::registry().size());  // comparisons point into results
+  std::vector<DANT::Bench::Comparison> comparisons;
+  for (const DANT::Bench::Benchmark& benchmark : DANT::Bench::registry()) {
+    if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+    results.push_back(
+        DANT::Bench::measure(benchmark, options.frames, options.repeats, counting ? &perfCounters : nullptr));
+    std::printf("%-48s %14.3f %14.3f", benchmark.name.c_str(), results.back().nsPerSampleChannel,
+                results.back().minNsPerSampleChannel);
+    if (counting) {
+      printCounters(results.back());
+    }
+    DANT::Bench::Comparison comparison;
+    if (comparing && DANT::Bench::compare(results.back(), baseline, options.tolerancePercent, comparison)) {
+      comparisons.push_back(comparison);
+      std::printf(" %14.3f %+9.1f%%%s", comparison.baselineNs, comparison.changePercent,
+                  comparison.regressed ? "  REGRESSION" : "");
+    } else if (comparing) {
+      std::printf(" %14s %10s", "-", "new");
+    }
+    std::printf("\n");
+  }
+
+  if (!options.jsonFile.empty() && !writeJson(results, options, options.jsonFile)) {
+    return 1;
+  }
+  if (options.saveBaseline && !writeJson(results, options, cpuBaselineFile)) {
+    return 1;
+  }
+  if (comparing && reportComparisons(comparisons, results.size(), options) > 0) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "perf-counters.hpp"
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+namespace DANT {
+namespace Bench {
+
+/**
+ * A benchmark processes numFrames frames of channels channels per run, timing is reported per sample-channel.
+ * Params are name/value labels used to group results, e.g. {"order", "AOCR"}.
+ * The optional setUp and tearDown are called around all of a benchmark's runs, outside the timings.
+ */
+struct Benchmark {
+  std::string name;
+  std::string group;
+  std::vector<std::pair<std::string, std::string>> params;
+  int channels;
+  std::function<void(const int numFrames)> run;
+  std::function<void()> setUp;
+  std::function<void()> tearDown;
+};
+
+struct Result {
+  const Benchmark* benchmark;
+  double nsPerSampleChannel;  // median over the repeats
+  double minNsPerSampleChannel;
+  int64_t samples;  // frames per repeat
+  PerfCounts counters;  // one extra run, when counters are enabled
+};
+
+inline std::vector<Benchmark>& registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+inline void add(const Benchmark& benchmark) { registry().push_back(benchmark); }
+
+// defined by each benchmark source, called once by the runner
+void addDspBenchmarks();
+void addAocrBenchmarks();
+void addBendBenchmarks();
+
+/**
+ * Stops the compiler from optimising away a value that is otherwise unused.
+ */
+template <typename T>
+inline void keep(const T& value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * Times the benchmark, then if counters is given counts one more run, so counting never affects the timings.
+ */
+inline Result measure(const Benchmark& benchmark, const int numFrames, const int repeats,
+                      PerfCounters* counters = nullptr) {
+  if (benchmark.setUp) {
+    benchmark.setUp();
+  }
+  benchmark.run(numFrames);  // warm up caches and branch predictors
+  std::vector<double> timings;
+  for (int r{0}; r < repeats; ++r) {
+    const auto start = std::chrono::steady_clock::now();
+    benchmark.run(numFrames);
+    const auto end = std::chrono::steady_clock::now();
+    const double ns{static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count())};
+    timings.push_back(ns / (static_cast<double>(numFrames) * benchmark.channels));
+  }
+  std::sort(timings.begin(), timings.end());
+  Result result{&benchmark, timings[timings.size() / 2], timings.front(), numFrames, PerfCounts{}};
+  if (counters) {
+    counters->start();
+    benchmark.run(numFrames);
+    result.counters = counters->stop();
+  }
+  if (benchmark.tearDown) {
+    benchmark.tearDown();
+  }
+  return result;
+}
+
+/**
+ * Threads that call read in a loop while a benchmark runs, like UI threads polling module state.
+ * Only meaningful with a spare core per reader, see hasSpareCores().
+ */
+struct Readers {
+  void start(const int numReaders, const std::function<void()>& read) {
+    this->running.store(true, std::memory_order_relaxed);
+    std::atomic<int> started{0};
+    for (int r{0}; r < numReaders; ++r) {
+      this->threads.emplace_back([this, read, &started]() {
+        started.fetch_add(1);
+        while (this->running.load(std::memory_order_relaxed)) {
+          read();
+        }
+      });
+    }
+    while (started.load() < numReaders) {
+      std::this_thread::yield();
+    }
+  }
+
+  void stop() {
+    this->running.store(false, std::memory_order_relaxed);
+    for (std::thread& thread : this->threads) {
+      thread.join();
+    }
+    this->threads.clear();
+  }
+
+  static bool hasSpareCores(const int numReaders) {
+    return std::thread::hardware_concurrency() > static_cast<unsigned>(numReaders);
+  }
+
+ private:
+  std::atomic<bool> running{false};
+  std::vector<std::thread> threads;
+};
+
+// CPU model name, results are only comparable on the same CPU
+inline std::string cpuModel() {
+#if defined(__linux__)
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.compare(0, 10, "model name") == 0 && line.find(':') != std::string::npos) {
+      return line.substr(line.find(':') + 2);
+    }
+  }
+#elif defined(__APPLE__)
+  char brand[256];
+  size_t size{sizeof(brand)};
+  if (sysctlbyname("machdep.cpu.brand_string", brand, &size, nullptr, 0) == 0) {
+    return std::string(brand);
+  }
+#endif
+  return "unknown";
+}
+
+}  // namespace Bench
+}  // namespace DANT
@@ -0,0 +1,105 @@
+#include "../src/modules/bend.cpp"
+#include "../src/modules/bend-expander.cpp"
+
+#include <memory>
+#include <rack.hpp>
+#include <string>
+
+#include "../tests/module-harness.hpp"
+#include "bench.hpp"
+
+namespace {
+
+const int READER_THREADS{2};
+
+// full module process, idle passes the signals through, active retriggers a long bend every 4096 frames
+// with numReaders, threads poll the module's snapshots throughout, like the UI of a busy patch
+// with eco, the plugin wide Eco mode setting is on while the benchmark runs
+void addBendProcess(const std::string& setting, const int numChannels, const bool active, const int numReaders = 0,
+                    const bool eco = false) {
+  std::shared_ptr<DANT::ModuleHarness<BendModule>> harness{new DANT::ModuleHarness<BendModule>()};
+  harness->module.inputs[BendModule::SIGNALS_INPUT].channels = numChannels;
+  harness->module.inputs[BendModule::BEND_TRIG_INPUT].channels = 1;
+  harness->setParam(BendModule::LENGTH_PARAM, 10.0f);
+  harness->setParam(BendModule::BEND_SHAPE_PARAM, 0.5f);
+
+  DANT::Bench::Benchmark benchmark;
+  benchmark.name = "module/bend/" + setting + "/" + std::to_string(numChannels) + "ch";
+  benchmark.group = "module/bend";
+  benchmark.params = {{"setting", setting}, {"channels", std::to_string(numChannels)}};
+  benchmark.channels = numChannels;
+  benchmark.run = [harness, numChannels, active](const int numFrames) {
+    float* voltages = harness->module.inputs[BendModule::SIGNALS_INPUT].voltages;
+    float* trigger = harness->module.inputs[BendModule::BEND_TRIG_INPUT].voltages;
+    for (int i{0}; i < numFrames; ++i) {
+      for (int c{0}; c < numChannels; ++c) {
+        voltages[c] = static_cast<float>(c) * 0.25f;
+      }
+      trigger[0] = (active && (i & 4095) == 16) ? 10.0f : 0.0f;
+      harness->step();
+    }
+    DANT::Bench::keep(harness->getOutput(BendModule::SIGNALS_OUTPUT));
+  };
+  if (numReaders > 0) {
+    std::shared_ptr<DANT::Bench::Readers> readers{std::make_shared<DANT::Bench::Readers>()};
+    benchmark.setUp = [harness, readers, numReaders]() {
+      readers->start(numReaders, [harness]() {
+        DANT::Bench::keep(harness->module.gridSnapshot.read());
+        DANT::Bench::keep(harness->module.cvSnapshot.read());
+      });
+    };
+    benchmark.tearDown = [readers]() { readers->stop(); };
+  }
+  if (eco) {
+    benchmark.setUp = []() { DANT::ECO_MODE.store(true); };
+    benchmark.tearDown = []() { DANT::ECO_MODE.store(DANT::DEFAULT_ECO_MODE); };
+  }
+  DANT::Bench::add(benchmark);
+}
+
+// active bends with a Bend Expander placed on the right, Bend sends its state and the expander outputs it
+void addBendExpanderProcess(const int numChannels) {
+  std::shared_ptr<DANT::ModuleHarness<BendModule>> harness{new DANT::ModuleHarness<BendModule>()};
+  std::shared_ptr<DANT::ModuleHarness<BendExpanderModule>> expander{
+      new DANT::ModuleHarness<BendExpanderModule>()};
+  harness->module.inputs[BendModule::SIGNALS_INPUT].channels = numChannels;
+  harness->module.inputs[BendModule::BEND_TRIG_INPUT].channels = 1;
+  harness->setParam(BendModule::LENGTH_PARAM, 10.0f);
+  harness->setParam(BendModule::BEND_SHAPE_PARAM, 0.5f);
+  harness->placeLeftOf(*expander);
+
+  DANT::Bench::Benchmark benchmark;
+  benchmark.name = "module/bend/expander/" + std::to_string(numChannels) + "ch";
+  benchmark.group = "module/bend";
+  benchmark.params = {{"setting", "expander"}, {"channels", std::to_string(numChannels)}};
+  benchmark.channels = numChannels;
+  benchmark.run = [harness, expander, numChannels](const int numFrames) {
+    float* voltages = harness->module.inputs[BendModule::SIGNALS_INPUT].voltages;
+    float* trigger = harness->module.inputs[BendModule::BEND_TRIG_INPUT].voltages;
+    for (int i{0}; i < numFrames; ++i) {
+      for (int c{0}; c < numChannels; ++c) {
+        voltages[c] = static_cast<float>(c) * 0.25f;
+      }
+      trigger[0] = (i & 4095) == 16 ? 10.0f : 0.0f;
+      harness->step();
+      expander->step();
+    }
+    DANT::Bench::keep(expander->getOutput(BendExpanderModule::ENVELOPE_OUTPUT));
+  };
+  DANT::Bench::add(benchmark);
+}
+
+}  // namespace
+
+void DANT::Bench::addBendBenchmarks() {
+  for (const int numChannels : {1, 4, 8, 16}) {
+    addBendProcess("idle", numChannels, false);
+    addBendProcess("active", numChannels, true);
+    addBendProcess("eco", numChannels, true, 0, true);
+    addBendExpanderProcess(numChannels);
+  }
+  // contended timings only mean something with a core per thread
+  if (DANT::Bench::Readers::hasSpareCores(READER_THREADS)) {
+    addBendProcess("readers", 16, true, READER_THREADS);
+  }
+}
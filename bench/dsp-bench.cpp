@@ -0,0 +1,142 @@
+#include <atomic>
+#include <memory>
+#include <rack.hpp>
+#include <string>
+
+#include "../src/dsp/att-off-clip-rect.hpp"
+#include "../src/dsp/bend-voct.hpp"
+#include "../src/dsp/cache-line.hpp"
+#include "bench.hpp"
+
+namespace {
+
+const int BUFFER_BLOCKS{256};
+const char* CLIP_NAMES[]{"NO_CLIP", "TEN_CLIP", "FIVE_CLIP"};
+const char* RECT_NAMES[]{"NO_RECT", "HALF_RECT", "FULL_RECT"};
+
+// ±12V ramp, so every clip and rectify branch sees both in and out of range signals
+struct RampBuffer {
+  rack::simd::float_4 blocks[BUFFER_BLOCKS];
+
+  RampBuffer() {
+    for (int b{0}; b < BUFFER_BLOCKS; ++b) {
+      for (int lane{0}; lane < DANT::SIMD; ++lane) {
+        const int sample{(b * DANT::SIMD) + lane};
+        blocks[b][lane] = -12.0f + (24.0f * static_cast<float>(sample) / (BUFFER_BLOCKS * DANT::SIMD));
+      }
+    }
+  }
+};
+
+const RampBuffer& ramp() {
+  static const RampBuffer buffer;
+  return buffer;
+}
+
+void addAttenuvertOffsetClipRectify(const DANT::OP_ORDER order, const DANT::CLIP_LVL clip, const DANT::RECT_LVL rect) {
+  const DANT::AOCROpts opts(order, -1.5f, 2.0f, clip, rect, DANT::RECT_TYPE::POS_RECT);
+  DANT::Bench::Benchmark benchmark;
+  benchmark.name = std::string("kernel/aocr/") + DANT::OP_ORDER_NAMES[order] + "/" + CLIP_NAMES[clip] + "/" +
+                   RECT_NAMES[rect];
+  benchmark.group = "kernel/aocr";
+  benchmark.params = {{"order", DANT::OP_ORDER_NAMES[order]}, {"clip", CLIP_NAMES[clip]}, {"rect", RECT_NAMES[rect]}};
+  benchmark.channels = DANT::SIMD;
+  benchmark.run = [opts](const int numFrames) {
+    const RampBuffer& input = ramp();
+    rack::simd::float_4 sum{0.0f};
+    for (int i{0}; i < numFrames; ++i) {
+      sum += DANT::attenuvertOffsetClipRectify(input.blocks[i % BUFFER_BLOCKS], opts);
+    }
+    DANT::Bench::keep(sum);
+  };
+  DANT::Bench::add(benchmark);
+}
+
+void addBendVoct(const float shape, const bool unbending) {
+  DANT::BendOpts opts;
+  opts.startOffsets = rack::simd::float_4(0.0f, 0.1f, -0.5f, 1.0f);
+  opts.targetOffsets = rack::simd::float_4(1.0f, -1.0f, 0.0f, 0.0f);
+  opts.shape = shape;
+  opts.isUnbending = unbending ? 1.0f : 0.0f;
+  opts.inverseUnbend = unbending;
+  DANT::Bench::Benchmark benchmark;
+  benchmark.name = "kernel/bend/" + rack::string::f("%+.1f", shape) + (unbending ? "/unbend" : "/bend");
+  benchmark.group = "kernel/bend";
+  benchmark.params = {{"shape", rack::string::f("%+.1f", shape)}, {"phase", unbending ? "unbend" : "bend"}};
+  benchmark.channels = DANT::SIMD;
+  benchmark.run = [opts](const int numFrames) {
+    const RampBuffer& input = ramp();
+    DANT::BendOpts frameOpts{opts};
+    const float progressStep{1.0f / static_cast<float>(numFrames)};
+    rack::simd::float_4 sum{0.0f};
+    for (int i{0}; i < numFrames; ++i) {
+      frameOpts.progress = static_cast<float>(i) * progressStep;
+      sum += DANT::bendVoct(input.blocks[i % BUFFER_BLOCKS], frameOpts);
+    }
+    DANT::Bench::keep(sum);
+  };
+  DANT::Bench::add(benchmark);
+}
+
+const int READER_THREADS{2};
+
+// per sample state next to a value other threads poll, the layout modules had before their hot state was grouped
+struct SharedLine : DANT::CacheAligned {
+  rack::simd::float_4 hot{0.0f};
+  std::atomic<uint32_t> published{0u};
+};
+
+// the same state with the polled value on a cache line of its own
+struct OwnLine : DANT::CacheAligned {
+  rack::simd::float_4 hot{0.0f};
+  alignas(DANT::CACHE_LINE) std::atomic<uint32_t> published{0u};
+};
+
+// the writer updates hot every sample and publishes every 256, while reader threads poll published
+template <typename TLayout>
+void addFalseSharing(const std::string& layout) {
+  std::shared_ptr<TLayout> state{new TLayout()};
+  std::shared_ptr<DANT::Bench::Readers> readers{std::make_shared<DANT::Bench::Readers>()};
+  DANT::Bench::Benchmark benchmark;
+  benchmark.name = "cache/readers/" + layout;
+  benchmark.group = "cache/readers";
+  benchmark.params = {{"layout", layout}};
+  benchmark.channels = DANT::SIMD;
+  benchmark.run = [state](const int numFrames) {
+    const RampBuffer& input = ramp();
+    for (int i{0}; i < numFrames; ++i) {
+      state->hot = rack::simd::fmax(state->hot, input.blocks[i % BUFFER_BLOCKS]);
+      DANT::Bench::keep(state->hot);
+      if ((i & 255) == 0) {
+        state->published.store(static_cast<uint32_t>(i), std::memory_order_release);
+      }
+    }
+  };
+  benchmark.setUp = [state, readers]() {
+    readers->start(READER_THREADS, [state]() { DANT::Bench::keep(state->published.load(std::memory_order_acquire)); });
+  };
+  benchmark.tearDown = [readers]() { readers->stop(); };
+  DANT::Bench::add(benchmark);
+}
+
+}  // namespace
+
+void DANT::Bench::addDspBenchmarks() {
+  for (int order{0}; order < DANT::NUM_OP_ORDERS; ++order) {
+    for (int clip{DANT::NO_CLIP}; clip <= DANT::FIVE_CLIP; ++clip) {
+      for (int rect{DANT::NO_RECT}; rect <= DANT::FULL_RECT; ++rect) {
+        addAttenuvertOffsetClipRectify(DANT::toOpOrder(order), static_cast<DANT::CLIP_LVL>(clip),
+                                       static_cast<DANT::RECT_LVL>(rect));
+      }
+    }
+  }
+  for (const float shape : {-1.0f, -0.5f, 0.0f, 0.5f, 1.0f}) {
+    addBendVoct(shape, false);
+    addBendVoct(shape, true);
+  }
+  // contended timings only mean something with a core per thread
+  if (DANT::Bench::Readers::hasSpareCores(READER_THREADS)) {
+    addFalseSharing<SharedLine>("shared-line");
+    addFalseSharing<OwnLine>("own-line");
+  }
+}
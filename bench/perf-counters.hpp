@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>  // std::memset
+#endif
+
+namespace DANT {
+namespace Bench {
+
+enum PERF_COUNTER {
+  CYCLES_COUNTER,
+  INSTRUCTIONS_COUNTER,
+  BRANCH_MISSES_COUNTER,
+  L1D_MISSES_COUNTER,  // L1 data cache read misses
+  NUM_PERF_COUNTERS,
+};
+
+static const char* const PERF_COUNTER_NAMES[NUM_PERF_COUNTERS]{"cycles", "instructions", "branch_misses",
+                                                               "l1d_misses"};
+
+/**
+ * Counts for one or more runs, a counter the CPU or kernel doesn't provide is not available and stays at 0.
+ */
+struct PerfCounts {
+  uint64_t values[NUM_PERF_COUNTERS]{};
+  bool available[NUM_PERF_COUNTERS]{};
+
+  PerfCounts& operator+=(const PerfCounts& other) {
+    for (int c{0}; c < NUM_PERF_COUNTERS; ++c) {
+      this->values[c] += other.values[c];
+      this->available[c] = other.available[c];
+    }
+    return *this;
+  }
+
+  bool any() const {
+    for (int c{0}; c < NUM_PERF_COUNTERS; ++c) {
+      if (this->available[c]) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // instructions per cycle, 0 if either counter is not available
+  double ipc() const {
+    return this->available[CYCLES_COUNTER] && this->available[INSTRUCTIONS_COUNTER] && this->values[CYCLES_COUNTER] > 0
+               ? static_cast<double>(this->values[INSTRUCTIONS_COUNTER]) / this->values[CYCLES_COUNTER]
+               : 0.0;
+  }
+
+  double perSample(const PERF_COUNTER counter, const int64_t samples) const {
+    return samples > 0 ? static_cast<double>(this->values[counter]) / static_cast<double>(samples) : 0.0;
+  }
+};
+
+/**
+ * Hardware performance counters for the calling thread through Linux perf_event_open, user space only.
+ * Each counter is opened on its own, so one the CPU doesn't have (common in VMs) doesn't disable the others.
+ * Counts are scaled up when the kernel multiplexes counters.
+ * Nothing is available on other platforms, or when perf_event_paranoid doesn't allow user space counting.
+ */
+struct PerfCounters {
+#if defined(__linux__)
+  PerfCounters() {
+    open(CYCLES_COUNTER, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    open(INSTRUCTIONS_COUNTER, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    open(BRANCH_MISSES_COUNTER, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    open(L1D_MISSES_COUNTER, PERF_TYPE_HW_CACHE,
+         PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+  }
+
+  ~PerfCounters() {
+    for (const int fd : this->fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+
+  bool isAvailable() const {
+    for (const int fd : this->fds) {
+      if (fd >= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void start() {
+    for (const int fd : this->fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+  }
+
+  PerfCounts stop() {
+    PerfCounts counts;
+    for (int c{0}; c < NUM_PERF_COUNTERS; ++c) {
+      if (this->fds[c] >= 0) {
+        ioctl(this->fds[c], PERF_EVENT_IOC_DISABLE, 0);
+      }
+    }
+    for (int c{0}; c < NUM_PERF_COUNTERS; ++c) {
+      uint64_t read[3];  // value, time enabled, time running
+      if (this->fds[c] < 0 || ::read(this->fds[c], read, sizeof(read)) != sizeof(read)) {
+        continue;
+      }
+      counts.available[c] = true;
+      counts.values[c] = read[2] > 0 && read[2] < read[1]
+                             ? static_cast<uint64_t>(static_cast<double>(read[0]) * read[1] / read[2])
+                             : read[0];
+    }
+    return counts;
+  }
+
+ private:
+  int fds[NUM_PERF_COUNTERS]{-1, -1, -1, -1};
+
+  void open(const PERF_COUNTER counter, const uint32_t type, const uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // this thread, any CPU, no group
+    this->fds[counter] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+#else
+  bool isAvailable() const { return false; }
+  void start() {}
+  PerfCounts stop() { return PerfCounts{}; }
+#endif
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+};
+
+}  // namespace Bench
+}  // namespace DANT
@@ -25,6 +25,29 @@ enum OP_ORDER {
   CROA,  // == RCOA
 };
 
+static const int NUM_OP_ORDERS{CROA + 1};
+
+/**
+ * Operation letters in the order they are applied, indexed by OP_ORDER.
+ * Single source for display labels and the order widget layout.
+ */
+constexpr char OP_ORDER_NAMES[NUM_OP_ORDERS][5]{"AOCR", "ACOR", "ACRO", "OACR", "OCAR", "OCRA",
+                                                "CAOR", "CARO", "COAR", "CORA", "CRAO", "CROA"};
+
+/**
+ * Step (0-3) at which operation letter op is applied in the given order, -1 if op is not an operation.
+ */
+constexpr int opStep(const OP_ORDER order, const char op, const int step = 0) {
+  return step > 3 ? -1 : (OP_ORDER_NAMES[order][step] == op ? step : opStep(order, op, step + 1));
+}
+
+static_assert(opStep(AOCR, 'R') == 3 && opStep(CROA, 'A') == 3 && opStep(OCRA, 'O') == 0, "OP_ORDER_NAMES mismatch");
+
+// converts a parameter int value to an order, out of range values fall back to AOCR
+inline OP_ORDER toOpOrder(const int value) {
+  return (value >= AOCR && value <= CROA) ? static_cast<OP_ORDER>(value) : AOCR;
+}
+
 enum CLIP_LVL { NO_CLIP, TEN_CLIP, FIVE_CLIP };
 
 enum RECT_LVL { NO_RECT, HALF_RECT, FULL_RECT };
@@ -53,19 +76,31 @@ struct AOCROpts {
       : opOrder(oo), attenuversion(a), offset(o), clipLvl(c), rectLvl(r), rectType(rt) {}
 };
 
-inline rack::simd::float_4 doA(const rack::simd::float_4 signals, const float attenuversion) {
+/**
+ * The operations are templated on the signal type, float_4 for channel blocks and float for the scalar mono path.
+ */
+inline float magnitude(const float signal) { return std::fabs(signal); }
+
+inline rack::simd::float_4 magnitude(const rack::simd::float_4 signals) { return rack::simd::abs(signals); }
+
+template <typename T>
+inline T doA(const T signals, const float attenuversion) {
   return signals * attenuversion;
 }
 
-inline rack::simd::float_4 doO(const rack::simd::float_4 signals, const float offset) { return signals + offset; }
+template <typename T>
+inline T doO(const T signals, const float offset) {
+  return signals + offset;
+}
 
-inline rack::simd::float_4 doC(const rack::simd::float_4 signals, const CLIP_LVL clipLvl) {
+template <typename T>
+inline T doC(const T signals, const CLIP_LVL clipLvl) {
   switch (clipLvl) {
     case TEN_CLIP:
-      return rack::simd::clamp(signals, M_TEN, P_TEN);
+      return rack::simd::fmax(rack::simd::fmin(signals, T(10.0f)), T(-10.0f));
       break;
     case FIVE_CLIP:
-      return rack::simd::clamp(signals, M_FIVE, P_FIVE);
+      return rack::simd::fmax(rack::simd::fmin(signals, T(5.0f)), T(-5.0f));
       break;
     default:
       return signals;
@@ -73,20 +108,21 @@ inline rack::simd::float_4 doC(const rack::simd::float_4 signals, const CLIP_LVL
   }
 }
 
-inline rack::simd::float_4 doR(const rack::simd::float_4 signals, const RECT_LVL rectLvl, const bool inverted = false) {
+template <typename T>
+inline T doR(const T signals, const RECT_LVL rectLvl, const bool inverted = false) {
   switch (rectLvl) {
     case HALF_RECT:
       if (inverted) {
-        return rack::simd::fmin(R_ZERO, signals);
+        return rack::simd::fmin(T(0.0f), signals);
       } else {
-        return rack::simd::fmax(R_ZERO, signals);
+        return rack::simd::fmax(T(0.0f), signals);
       }
       break;
     case FULL_RECT:
       if (inverted) {
-        return rack::simd::abs(signals) * -1.0f;
+        return magnitude(signals) * -1.0f;
       } else {
-        return rack::simd::abs(signals);
+        return magnitude(signals);
       }
       break;
     default:
@@ -95,8 +131,9 @@ inline rack::simd::float_4 doR(const rack::simd::float_4 signals, const RECT_LVL
   }
 }
 
-rack::simd::float_4 attenuvertOffsetClipRectify(const rack::simd::float_4 inSignals, AOCROpts opts) {
-  rack::simd::float_4 outSignals{inSignals};
+template <typename T>
+inline T attenuvertOffsetClipRectify(const T inSignals, AOCROpts opts) {
+  T outSignals{inSignals};
   switch (opts.opOrder) {
     case AOCR:
       outSignals = DANT::doA(outSignals, opts.attenuversion);
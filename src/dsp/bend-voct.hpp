@@ -8,6 +8,9 @@ namespace DANT {
 
 enum BEND_DIR { TOWARDS_PITCH, AWAY_FROM_PITCH };
 
+// precision of the bend curve, ECO_MATH trades under a cent of accuracy for a cheaper pow, used in Eco mode
+enum BEND_MATH { PRECISE_MATH, ECO_MATH };
+
 struct BendOpts {
   rack::simd::float_4 startOffsets{0.0f};
   rack::simd::float_4 targetOffsets{0.0f};
@@ -15,11 +18,40 @@ struct BendOpts {
   rack::simd::float_4 shape{0.0f};
   rack::simd::float_4 isUnbending{0.0f};
   bool inverseUnbend{false};
+  BEND_MATH math{PRECISE_MATH};
 
   BendOpts() = default;
 };
 
-inline rack::simd::float_4 bendVoct(const rack::simd::float_4 inSignals, BendOpts opts) {
+/**
+ * Approximate log2 for positive normal floats, the float's exponent plus a polynomial for ln of its mantissa.
+ * Absolute error under 1e-4.
+ */
+inline rack::simd::float_4 approxLog2(const rack::simd::float_4 x) {
+  const __m128i bits = _mm_castps_si128(x.v);
+  const rack::simd::float_4 exponent{_mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)))};
+  // mantissa in [1, 2)
+  const rack::simd::float_4 m{
+      _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)))};
+  const rack::simd::float_4 lnM{-1.7417939f +
+                                (2.8212026f + (-1.4699568f + (0.44717955f - 0.056570851f * m) * m) * m) * m};
+  return exponent + (lnM * 1.44269504f);
+}
+
+// pow for p in (0, 1] through exp2 and approxLog2, clamped above the smallest normal float
+inline rack::simd::float_4 approxPow(const rack::simd::float_4 p, const rack::simd::float_4 exponents) {
+  return rack::dsp::exp2_taylor5(rack::simd::fmax(exponents * approxLog2(p), -126.0f));
+}
+
+// the bend curve p^exponents, 0 at p <= 0
+inline rack::simd::float_4 bendCurve(const rack::simd::float_4 p, const rack::simd::float_4 exponents,
+                                     const BEND_MATH math) {
+  const rack::simd::float_4 curved{math == ECO_MATH ? approxPow(p, exponents) : rack::simd::pow(p, exponents)};
+  return rack::simd::ifelse(p > 0.0f, curved, 0.0f);
+}
+
+// the curve the offsets move along, 0 to 1 over the progress
+inline rack::simd::float_4 bendProgressCurve(const BendOpts& opts) {
   rack::simd::float_4 p = rack::simd::clamp(opts.progress, 0.0f, 1.0f);
 
   // Exponent derived from shape: pow(2, shape * 2.0)
@@ -28,7 +60,7 @@ inline rack::simd::float_4 bendVoct(const rack::simd::float_4 inSignals, BendOpt
   // shape = 1 (exp) -> exp = 4.0
   rack::simd::float_4 exponents = rack::dsp::exp2_taylor5(opts.shape * 2.0f);
 
-  rack::simd::float_4 curved = rack::simd::ifelse(p > 0.0f, rack::simd::pow(p, exponents), 0.0f);
+  rack::simd::float_4 curved = bendCurve(p, exponents, opts.math);
 
   if (opts.inverseUnbend) {
     // If we want a symmetric "hill", the return curve should be inverted in time.
@@ -36,13 +68,27 @@ inline rack::simd::float_4 bendVoct(const rack::simd::float_4 inSignals, BendOpt
     // We achieve an exact time-domain mirror reflection by running the progress backward:
     // f(p) = 1.0 - (1.0 - p)^e
     rack::simd::float_4 p_inv = 1.0f - p;
-    rack::simd::float_4 unbendCurve = 1.0f - rack::simd::ifelse(p_inv > 0.0f, rack::simd::pow(p_inv, exponents), 0.0f);
+    rack::simd::float_4 unbendCurve = 1.0f - bendCurve(p_inv, exponents, opts.math);
     curved = rack::simd::ifelse(opts.isUnbending != 0.0f, unbendCurve, curved);
   }
+  return curved;
+}
+
+inline rack::simd::float_4 bendVoct(const rack::simd::float_4 inSignals, BendOpts opts) {
+  rack::simd::float_4 curved = bendProgressCurve(opts);
 
   rack::simd::float_4 offsets = opts.startOffsets + (opts.targetOffsets - opts.startOffsets) * curved;
 
   return inSignals + offsets;
 }
 
+/**
+ * The bend as an envelope, 0 at the start of a bend rising along its curve to 1 at its end, whatever its direction.
+ * An unbend falls along its own curve to 0 from unbendFrom, the envelope when the unbend started.
+ */
+inline rack::simd::float_4 bendEnvelope(const BendOpts& opts, const rack::simd::float_4 unbendFrom) {
+  const rack::simd::float_4 curved{bendProgressCurve(opts)};
+  return rack::simd::ifelse(opts.isUnbending != 0.0f, unbendFrom * (1.0f - curved), curved);
+}
+
 }  // namespace DANT
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace DANT {
+
+// alignment that keeps data written by one thread off the cache lines another thread reads, avoiding false sharing
+static const int CACHE_LINE{64};
+
+/**
+ * Allocation for types holding alignas(CACHE_LINE) members.
+ * Before C++17 new only guarantees alignof(std::max_align_t), so the alignment would hold within the object but not
+ * in memory, this allocates on a cache line boundary instead.
+ * Modules are created with new and deleted through a Module pointer, the virtual destructor picks up these.
+ */
+struct CacheAligned {
+  static void* operator new(const std::size_t size) {
+    void* block{std::malloc(size + CACHE_LINE + sizeof(void*))};
+    if (!block) {
+      throw std::bad_alloc();
+    }
+    // the original block is stored just before the aligned address
+    const uintptr_t start{reinterpret_cast<uintptr_t>(block) + sizeof(void*)};
+    void** aligned = reinterpret_cast<void**>((start + CACHE_LINE - 1u) & ~static_cast<uintptr_t>(CACHE_LINE - 1));
+    aligned[-1] = block;
+    return aligned;
+  }
+
+  static void operator delete(void* ptr) {
+    if (ptr) {
+      std::free(static_cast<void**>(ptr)[-1]);
+    }
+  }
+};
+
+inline bool isCacheAligned(const void* ptr) {
+  return (reinterpret_cast<uintptr_t>(ptr) & static_cast<uintptr_t>(CACHE_LINE - 1)) == 0u;
+}
+
+}  // namespace DANT
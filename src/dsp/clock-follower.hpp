@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cmath>
+#include <rack.hpp>
+
+namespace DANT {
+
+static const float CLOCK_PHASE_GAIN{0.5f};     // share of an edge's timing error taken into the phase
+static const float CLOCK_PERIOD_GAIN{0.25f};   // share of an edge's timing error taken into the period
+static const float CLOCK_OUTLIER_RATIO{0.2f};  // intervals further than this from the period are outliers
+static const int CLOCK_RELOCK_OUTLIERS{3};     // outliers in a row that are a tempo change, not a glitch
+
+/**
+ * Phase locked clock follower, tracks the period and phase of a clock input from its rising edges.
+ * An alpha-beta filter on the edge times, each edge moves the predicted edge by CLOCK_PHASE_GAIN of its timing error
+ * and the period by CLOCK_PERIOD_GAIN, so clock jitter is smoothed instead of passed on to every bend.
+ * A missed or doubled pulse is an outlier, it only moves the phase, CLOCK_RELOCK_OUTLIERS in a row relock the period
+ * to the latest interval. Edges are timed to a fraction of a sample by interpolating the 1V threshold crossing.
+ * The period survives restart(), so a reconnected clock, or one restored from a patch, has a period straight away.
+ */
+struct ClockFollower {
+  // advances by one sample of the clock input, returns true when the period changed
+  bool process(const float in, const float sampleTime) {
+    const float previous{this->previousIn};
+    this->previousIn = in;
+    this->sinceEdge += sampleTime;
+    if (!this->trigger.process(in)) {
+      return false;
+    }
+    // the crossing was up to a sample before the current sample
+    const float rise{in - previous};
+    const float edgeDelay{rise > 0.0f ? rack::math::clamp((in - 1.0f) / rise, 0.0f, 1.0f) * sampleTime : 0.0f};
+    return this->edge(edgeDelay);
+  }
+
+  // smoothed seconds between edges, 0 until the first interval is measured or a period is restored
+  float period() const { return this->periodSeconds; }
+
+  // seconds until the predicted next edge, negative when it is late
+  float nextEdge() const { return this->periodSeconds - static_cast<float>(this->sinceEdge); }
+
+  // position within the predicted beat, 0 at an edge, 1 at the next
+  float phase() const {
+    return this->periodSeconds > 0.0f ? rack::math::clamp(static_cast<float>(this->sinceEdge) / this->periodSeconds,
+                                                          0.0f, 1.0f)
+                                      : 0.0f;
+  }
+
+  // a period to start from, e.g. saved with the patch, replaced by the first interval measured
+  void restore(const float seconds) {
+    this->periodSeconds = std::fmax(0.0f, seconds);
+    this->restart();
+  }
+
+  // the clock was disconnected, keeps the period, the next interval measured replaces it
+  void restart() {
+    this->trigger.reset();
+    this->previousIn = 0.0f;
+    this->sinceEdge = 0.0;
+    this->hasEdge = false;
+    this->measured = false;
+    this->outliers = 0;
+  }
+
+  void reset() { this->restore(0.0f); }
+
+ private:
+  rack::dsp::SchmittTrigger trigger;
+  float previousIn{0.0f};
+  double sinceEdge{0.0};  // seconds since the phase reference, double so a slow clock's sum of sample times is exact
+  float periodSeconds{0.0f};
+  bool hasEdge{false};
+  bool measured{false};  // an interval has been measured since the last restart
+  int outliers{0};
+
+  bool edge(const float edgeDelay) {
+    const float interval{static_cast<float>(this->sinceEdge) - edgeDelay};
+    this->sinceEdge = edgeDelay;
+    if (!this->hasEdge) {
+      this->hasEdge = true;
+      return false;
+    }
+    if (!this->measured) {
+      this->measured = true;
+      return this->lock(interval);
+    }
+    const float error{interval - this->periodSeconds};
+    if (std::fabs(error) > CLOCK_OUTLIER_RATIO * this->periodSeconds) {
+      // re-referenced to this edge, so a missed pulse doesn't make the next interval an outlier too
+      return ++this->outliers >= CLOCK_RELOCK_OUTLIERS ? this->lock(interval) : false;
+    }
+    this->outliers = 0;
+    this->periodSeconds += CLOCK_PERIOD_GAIN * error;
+    this->sinceEdge += (1.0f - CLOCK_PHASE_GAIN) * error;
+    return true;
+  }
+
+  bool lock(const float interval) {
+    this->outliers = 0;
+    this->periodSeconds = interval;
+    return true;
+  }
+};
+
+}  // namespace DANT
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <rack.hpp>
+
+#include "../static.hpp"
+
+namespace DANT {
+
+static const int BLOCK_BITS{0xF};  // the lanes of one float_4 block
+
+// bits of the valid channels in a block, e.g. 0x3 for block 1 of 6 channels
+inline int validLanes(const int numChannels, const int block) {
+  const int lanes{numChannels - (block * DANT::SIMD)};
+  return lanes >= DANT::SIMD ? BLOCK_BITS : lanes > 0 ? (1 << lanes) - 1 : 0;
+}
+
+/**
+ * Float_4 comparison masks for each combination of 4 lane bits, lane i is set when bit i is.
+ */
+struct LaneMaskTable {
+  rack::simd::float_4 masks[BLOCK_BITS + 1];
+
+  LaneMaskTable() {
+    for (int bits{0}; bits <= BLOCK_BITS; ++bits) {
+      const rack::simd::float_4 flags{static_cast<float>(bits & 1), static_cast<float>((bits >> 1) & 1),
+                                      static_cast<float>((bits >> 2) & 1), static_cast<float>((bits >> 3) & 1)};
+      this->masks[bits] = flags != 0.0f;
+    }
+  }
+};
+
+static const LaneMaskTable LANE_MASKS;
+
+/**
+ * A boolean per channel packed into 16 bits, bit c is channel c, so block b is bits 4b to 4b + 3.
+ * Replaces a float_4 of 0.0f/1.0f flags per block, 2 bytes instead of 64.
+ */
+struct LaneMask {
+  uint16_t bits{0u};
+
+  bool test(const int channel) const { return ((this->bits >> channel) & 1u) != 0u; }
+
+  // the block's 4 lane bits
+  int block(const int block) const { return (this->bits >> (block * DANT::SIMD)) & BLOCK_BITS; }
+
+  // the block's lanes as a comparison mask, for ifelse and &
+  rack::simd::float_4 mask(const int block) const { return LANE_MASKS.masks[this->block(block)]; }
+
+  // the block's unset lanes as a comparison mask
+  rack::simd::float_4 unsetMask(const int block) const { return LANE_MASKS.masks[BLOCK_BITS & ~this->block(block)]; }
+
+  void set(const int channel, const bool value) {
+    this->bits = value ? static_cast<uint16_t>(this->bits | (1u << channel))
+                       : static_cast<uint16_t>(this->bits & ~(1u << channel));
+  }
+
+  // sets or clears the lanes selected by a block's comparison mask
+  void set(const int block, const rack::simd::float_4 selected, const bool value) {
+    const uint16_t lanes{static_cast<uint16_t>(rack::simd::movemask(selected) << (block * DANT::SIMD))};
+    this->bits = value ? static_cast<uint16_t>(this->bits | lanes) : static_cast<uint16_t>(this->bits & ~lanes);
+  }
+
+  void clear() { this->bits = 0u; }
+};
+
+/**
+ * Schmitt triggers for 16 channels packed into 16 bits, processed a float_4 block at a time.
+ * Same thresholds and behaviour as rack::dsp::SchmittTrigger, including starting high,
+ * so an input must go low before it can fire.
+ */
+struct TriggerLanes {
+  uint16_t high{0xFFFFu};
+
+  // processes the block's lanes selected by lanes, returns the bits of the lanes that fired
+  int process(const int block, const rack::simd::float_4 in, const int lanes = BLOCK_BITS,
+              const float lowThreshold = 0.0f, const float highThreshold = 1.0f) {
+    const int shift{block * DANT::SIMD};
+    const int state{(this->high >> shift) & BLOCK_BITS};
+    const int lows{rack::simd::movemask(in <= lowThreshold)};
+    const int highs{rack::simd::movemask(in >= highThreshold)};
+    // high lanes stay high until they go low, low lanes go high and fire at the high threshold
+    const int fired{~state & highs & lanes};
+    const int next{((state & ~lows) | (~state & highs)) & lanes};
+    this->high = static_cast<uint16_t>((this->high & ~(lanes << shift)) | (next << shift));
+    return fired;
+  }
+
+  bool isHigh(const int channel) const { return ((this->high >> channel) & 1u) != 0u; }
+
+  // the lane's next high input fires, even if the input never went low
+  void rearm(const int channel) { this->high = static_cast<uint16_t>(this->high & ~(1u << channel)); }
+
+  void reset() { this->high = 0xFFFFu; }
+};
+
+/**
+ * Sub-sample trigger onset, how long before the current sample the input crossed the high threshold, in samples.
+ * Linear interpolation between the previous and current input, 0 when the input didn't rise, limited to [0, 1].
+ * A trigger that steps straight from 0V to 10V crossed 1V 0.9 samples ago.
+ */
+inline rack::simd::float_4 onsetDelay(const rack::simd::float_4 previous, const rack::simd::float_4 in,
+                                      const float highThreshold = 1.0f) {
+  const rack::simd::float_4 rise{in - previous};
+  const rack::simd::float_4 delay{(in - highThreshold) / rack::simd::ifelse(rise > 0.0f, rise, 1.0f)};
+  return rack::simd::ifelse(rise > 0.0f, rack::simd::clamp(delay, 0.0f, 1.0f), 0.0f);
+}
+
+}  // namespace DANT
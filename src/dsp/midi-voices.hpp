@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <rack.hpp>
+
+#include "../static.hpp"
+#include "lane-mask.hpp"
+
+namespace DANT {
+
+/**
+ * Polyphonic assignment of MIDI notes to up to 16 voices, one per lane, with the pitch wheel and aftertouch.
+ * A new note takes the first free voice after the last one assigned, so a released voice's unbend can finish before
+ * the voice is reused. With every voice held the oldest note is stolen, a note that is already held retriggers its
+ * own voice. Voices keep their last note's pitch after release.
+ */
+struct MidiVoices {
+  int notes[DANT::CHANS];       // the last note of each voice, -1 before its first note
+  DANT::LaneMask gates;         // voices with a held note
+  float pressure[DANT::CHANS];  // aftertouch 0 to 1, channel pressure sets every voice
+  float wheel{0.0f};            // pitch wheel -1 to 1
+
+  MidiVoices() { this->reset(); }
+
+  // applies a message, returns the voice a note on started, -1 for anything else
+  int process(const rack::midi::Message& message) {
+    switch (message.getStatus()) {
+      case 0x8:  // note off
+        this->noteOff(message.getNote());
+        return -1;
+      case 0x9:  // note on, velocity 0 is a note off
+        if (message.getValue() > 0) {
+          return this->noteOn(message.getNote());
+        }
+        this->noteOff(message.getNote());
+        return -1;
+      case 0xa: {  // polyphonic key pressure
+        const int voice{this->heldVoice(message.getNote())};
+        if (voice >= 0) {
+          this->pressure[voice] = message.getValue() / 127.0f;
+        }
+        return -1;
+      }
+      case 0xb:  // all sound off and all notes off
+        if (message.getNote() == 120 || message.getNote() == 123) {
+          this->gates.clear();
+        }
+        return -1;
+      case 0xd:  // channel pressure, a single data byte
+        for (float& p : this->pressure) {
+          p = message.getNote() / 127.0f;
+        }
+        return -1;
+      case 0xe:  // pitch wheel, 14 bits centred on 8192
+        this->wheel = rack::math::clamp(
+            static_cast<float>(((message.getValue() << 7) | message.getNote()) - 8192) / 8191.0f, -1.0f, 1.0f);
+        return -1;
+      default:
+        return -1;
+    }
+  }
+
+  // voices above numVoices are released
+  void setVoices(const int numVoices) {
+    this->numVoices = rack::math::clamp(numVoices, 1, DANT::CHANS);
+    this->gates.bits = static_cast<uint16_t>(this->gates.bits & ((1u << this->numVoices) - 1u));
+    this->lastVoice = -1;
+  }
+
+  int getVoices() const { return this->numVoices; }
+
+  // V/Oct, middle C is 0V
+  float pitch(const int voice) const {
+    return this->notes[voice] < 0 ? 0.0f : static_cast<float>(this->notes[voice] - 60) / 12.0f;
+  }
+
+  void reset() {
+    for (int voice{0}; voice < DANT::CHANS; ++voice) {
+      this->notes[voice] = -1;
+      this->pressure[voice] = 0.0f;
+      this->ages[voice] = 0u;
+    }
+    this->gates.clear();
+    this->wheel = 0.0f;
+    this->lastVoice = -1;
+    this->age = 0u;
+  }
+
+ private:
+  int numVoices{1};
+  int lastVoice{-1};
+  uint32_t ages[DANT::CHANS];  // when each voice's note started
+  uint32_t age{0u};
+
+  int noteOn(const int note) {
+    int voice{this->heldVoice(note)};
+    if (voice < 0) {
+      voice = this->freeVoice();
+    }
+    if (voice < 0) {
+      voice = this->oldestVoice();
+    }
+    this->notes[voice] = note;
+    this->gates.set(voice, true);
+    this->pressure[voice] = 0.0f;
+    this->ages[voice] = ++this->age;
+    this->lastVoice = voice;
+    return voice;
+  }
+
+  void noteOff(const int note) {
+    const int voice{this->heldVoice(note)};
+    if (voice >= 0) {
+      this->gates.set(voice, false);
+    }
+  }
+
+  int heldVoice(const int note) const {
+    for (int voice{0}; voice < this->numVoices; ++voice) {
+      if (this->gates.test(voice) && this->notes[voice] == note) {
+        return voice;
+      }
+    }
+    return -1;
+  }
+
+  int freeVoice() const {
+    for (int i{1}; i <= this->numVoices; ++i) {
+      const int voice{(this->lastVoice + i) % this->numVoices};
+      if (!this->gates.test(voice)) {
+        return voice;
+      }
+    }
+    return -1;
+  }
+
+  int oldestVoice() const {
+    int oldest{0};
+    for (int voice{1}; voice < this->numVoices; ++voice) {
+      if (this->ages[voice] < this->ages[oldest]) {
+        oldest = voice;
+      }
+    }
+    return oldest;
+  }
+};
+
+}  // namespace DANT
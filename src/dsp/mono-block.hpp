@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>  // std::fill
+
+#include "../static.hpp"
+
+namespace DANT {
+
+static const int MONO_BLOCK_FRAMES{DANT::SIMD};
+
+/**
+ * Buffers a mono signal into blocks of 4 frames, so a float_4 kernel processes 4 consecutive samples of one channel
+ * instead of 4 channels of one sample.
+ * The kernel is called as float_4 kernel(float_4 frames) as soon as a block has filled.
+ * Output is delayed by exactly the block length, see latency().
+ */
+struct MonoBlock {
+  MonoBlock() { reset(); }
+
+  // resets the buffered signal
+  void setEnabled(const bool enabled) {
+    this->enabled = enabled;
+    reset();
+  }
+
+  bool isEnabled() const { return this->enabled; }
+
+  // added latency in samples
+  int latency() const { return this->enabled ? MONO_BLOCK_FRAMES : 0; }
+
+  void reset() {
+    std::fill(inputs, inputs + MONO_BLOCK_FRAMES, 0.0f);
+    std::fill(outputs, outputs + MONO_BLOCK_FRAMES, 0.0f);
+    this->position = 0;
+  }
+
+  template <typename Kernel>
+  inline float process(const float input, Kernel&& kernel) {
+    const float output{outputs[this->position]};
+    inputs[this->position] = input;
+    if (++this->position == MONO_BLOCK_FRAMES) {
+      // the block's outputs were all read, they're next read over the following block
+      rack::simd::float_4 processed{kernel(rack::simd::float_4::load(inputs))};
+      processed.store(outputs);
+      this->position = 0;
+    }
+    return output;
+  }
+
+ private:
+  bool enabled{false};
+  int position{0};
+  alignas(16) float inputs[MONO_BLOCK_FRAMES];
+  alignas(16) float outputs[MONO_BLOCK_FRAMES];
+};
+
+}  // namespace DANT
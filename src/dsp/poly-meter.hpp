@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>  // std::fill
+
+#include "../static.hpp"
+
+namespace DANT {
+
+/**
+ * Reduces a polyphonic signal to per channel levels over an interval, e.g. between UI snapshots.
+ * Per sample cost is a max, a min and a multiply-add for each float_4 block.
+ * Peaks keep the polarity of the larger excursion and decay between intervals, RMS takes the same polarity.
+ */
+struct PolyMeter {
+  float peakDecay{0.8f};  // fraction of the held peak kept after each interval
+
+  rack::simd::float_4 peak[DANT::SIMD];  // reduced signed peak, valid after reduce()
+  rack::simd::float_4 rms[DANT::SIMD];   // reduced signed RMS, valid after reduce()
+
+  PolyMeter() { reset(); }
+
+  void reset() {
+    std::fill(peak, peak + DANT::SIMD, DANT::SIMD_ZERO);
+    std::fill(rms, rms + DANT::SIMD, DANT::SIMD_ZERO);
+    std::fill(heldPeak, heldPeak + DANT::SIMD, DANT::SIMD_ZERO);
+    clearAccumulators();
+  }
+
+  inline void process(const rack::simd::float_4 signals, const int block) {
+    positivePeak[block] = rack::simd::fmax(positivePeak[block], signals);
+    negativePeak[block] = rack::simd::fmin(negativePeak[block], signals);
+    sumOfSquares[block] += signals * signals;
+  }
+
+  // scalar variant of process for mono signals, accumulates channel 0 only
+  inline void processMono(const float signal) {
+    positivePeak[0][0] = std::fmax(positivePeak[0][0], signal);
+    negativePeak[0][0] = std::fmin(negativePeak[0][0], signal);
+    sumOfSquares[0][0] += signal * signal;
+  }
+
+  // mono block mode variant, frames holds 4 consecutive samples of channel 0
+  inline void processMonoFrames(const rack::simd::float_4 frames) {
+    const float maxFrame{std::fmax(std::fmax(frames[0], frames[1]), std::fmax(frames[2], frames[3]))};
+    const float minFrame{std::fmin(std::fmin(frames[0], frames[1]), std::fmin(frames[2], frames[3]))};
+    const rack::simd::float_4 squares{frames * frames};
+    positivePeak[0][0] = std::fmax(positivePeak[0][0], maxFrame);
+    negativePeak[0][0] = std::fmin(negativePeak[0][0], minFrame);
+    sumOfSquares[0][0] += (squares[0] + squares[1]) + (squares[2] + squares[3]);
+  }
+
+  // numSamples is the length of the interval just accumulated
+  void reduce(const int numSamples) {
+    const float meanScale{numSamples > 0 ? 1.0f / static_cast<float>(numSamples) : 0.0f};
+    for (int b{0}; b < DANT::SIMD; ++b) {
+      rack::simd::float_4 intervalPeak{
+          rack::simd::ifelse(positivePeak[b] >= -negativePeak[b], positivePeak[b], negativePeak[b])};
+      rack::simd::float_4 decayedPeak{heldPeak[b] * peakDecay};
+      heldPeak[b] = rack::simd::ifelse(rack::simd::abs(intervalPeak) >= rack::simd::abs(decayedPeak), intervalPeak,
+                                       decayedPeak);
+      peak[b] = heldPeak[b];
+
+      rack::simd::float_4 magnitude{rack::simd::sqrt(sumOfSquares[b] * meanScale)};
+      rms[b] = rack::simd::ifelse(heldPeak[b] < 0.0f, -magnitude, magnitude);
+    }
+    clearAccumulators();
+  }
+
+ private:
+  rack::simd::float_4 heldPeak[DANT::SIMD];
+  rack::simd::float_4 positivePeak[DANT::SIMD];
+  rack::simd::float_4 negativePeak[DANT::SIMD];
+  rack::simd::float_4 sumOfSquares[DANT::SIMD];
+
+  void clearAccumulators() {
+    std::fill(positivePeak, positivePeak + DANT::SIMD, DANT::SIMD_ZERO);
+    std::fill(negativePeak, negativePeak + DANT::SIMD, DANT::SIMD_ZERO);
+    std::fill(sumOfSquares, sumOfSquares + DANT::SIMD, DANT::SIMD_ZERO);
+  }
+};
+
+}  // namespace DANT
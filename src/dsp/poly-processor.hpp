@@ -0,0 +1,165 @@
+#pragma once
+
+#include <rack.hpp>
+
+#include "../static.hpp"
+
+namespace DANT {
+
+/**
+ * Specialised process paths, selected by channel count.
+ */
+enum CHANNEL_PATH {
+  NO_CHANS,    // disconnected, nothing to process
+  MONO_CHANS,  // 1 channel, scalar
+  QUAD_CHANS,  // 2-4 channels, 1 block
+  OCTO_CHANS,  // 5-8 channels, 2 blocks
+  TRI_CHANS,   // 9-12 channels, 3 blocks
+  FULL_CHANS,  // 13-16 channels, 4 blocks
+};
+
+inline CHANNEL_PATH channelPathFor(const int numChannels) {
+  return numChannels <= 0 ? NO_CHANS
+         : numChannels == 1 ? MONO_CHANS
+         : numChannels <= 4 ? QUAD_CHANS
+         : numChannels <= 8 ? OCTO_CHANS
+         : numChannels <= 12 ? TRI_CHANS
+                             : FULL_CHANS;
+}
+
+/**
+ * Remembers the path for the last channel count, so the path is only reselected when the count changes.
+ */
+struct ChannelPathSelector {
+  CHANNEL_PATH select(const int numChannels) {
+    if (numChannels != this->numChannels) {
+      this->numChannels = numChannels;
+      this->path = channelPathFor(numChannels);
+    }
+    return this->path;
+  }
+
+ private:
+  int numChannels{-1};
+  CHANNEL_PATH path{NO_CHANS};
+};
+
+/**
+ * Channel blocked SIMD loop shared by the modules, T selects the vector width.
+ * Input and output voltages are read and written straight from the ports' aligned voltage arrays,
+ * skipping the per block connected/monophonic checks of the Port SIMD accessors.
+ * Lanes past the channel count are masked off by a table built once, indexed by channel count and block.
+ *
+ * The kernel is called once per block as T kernel(int block, int channel, T inputs, T validMask),
+ * where channel is the first channel of the block, and returns the output block.
+ */
+template <typename T = rack::simd::float_4>
+struct PolyProcessor {
+  static const int WIDTH{T::size};
+  static const int BLOCKS{DANT::CHANS / T::size};
+
+  struct MaskTable {
+    T masks[DANT::CHANS + 1][BLOCKS];
+
+    MaskTable() {
+      for (int numChannels{0}; numChannels <= DANT::CHANS; ++numChannels) {
+        for (int block{0}; block < BLOCKS; ++block) {
+          T mask{T::zero()};
+          for (int lane{0}; lane < WIDTH; ++lane) {
+            if ((block * WIDTH) + lane < numChannels) {
+              mask[lane] = 1.0f;
+            }
+          }
+          masks[numChannels][block] = mask != 0.0f;  // all bits set on valid lanes
+        }
+      }
+    }
+  };
+
+  static const T& validMask(const int numChannels, const int block) {
+    static const MaskTable table;
+    return table.masks[numChannels][block];
+  }
+
+  template <typename Kernel>
+  static void process(rack::engine::Input& input, rack::engine::Output& output, const int numChannels,
+                      Kernel&& kernel) {
+    for (int c{0}; c < numChannels; c += WIDTH) {
+      const int block{c / WIDTH};
+      const T inputs{T::load(&input.voltages[c])};
+      T outputs{kernel(block, c, inputs, validMask(numChannels, block))};
+      outputs.store(&output.voltages[c]);
+    }
+    output.setChannels(numChannels);
+  }
+
+  /**
+   * Fixed block count variant of process, the block loop is unrolled at compile time.
+   * numChannels must be within the NUM_BLOCKS * WIDTH channels the blocks cover.
+   */
+  template <int NUM_BLOCKS, typename Kernel>
+  static void processBlocks(rack::engine::Input& input, rack::engine::Output& output, const int numChannels,
+                            Kernel&& kernel) {
+    static_assert(NUM_BLOCKS > 0 && NUM_BLOCKS <= BLOCKS, "block count out of range");
+    Unrolled<0, NUM_BLOCKS>::run(input.voltages, output.voltages, numChannels, kernel);
+    output.setChannels(numChannels);
+  }
+
+  /**
+   * Runs the block kernel through the path specialised for the channel count, for modules without a scalar kernel.
+   * The mono path uses a single block.
+   */
+  template <typename Kernel>
+  static void process(const CHANNEL_PATH path, rack::engine::Input& input, rack::engine::Output& output,
+                      const int numChannels, Kernel&& kernel) {
+    switch (path) {
+      case MONO_CHANS:
+      case QUAD_CHANS:
+        processBlocks<blocksFor(4)>(input, output, numChannels, kernel);
+        break;
+      case OCTO_CHANS:
+        processBlocks<blocksFor(8)>(input, output, numChannels, kernel);
+        break;
+      case TRI_CHANS:
+        processBlocks<blocksFor(12)>(input, output, numChannels, kernel);
+        break;
+      case FULL_CHANS:
+        processBlocks<BLOCKS>(input, output, numChannels, kernel);
+        break;
+      default:
+        output.setChannels(0);
+        break;
+    }
+  }
+
+  /**
+   * Scalar mono path, the kernel is called as float kernel(float input).
+   */
+  template <typename ScalarKernel>
+  static void processMono(rack::engine::Input& input, rack::engine::Output& output, ScalarKernel&& kernel) {
+    output.voltages[0] = kernel(input.voltages[0]);
+    output.setChannels(1);
+  }
+
+ private:
+  static constexpr int blocksFor(const int numChannels) { return (numChannels + WIDTH - 1) / WIDTH; }
+
+  template <int BLOCK, int NUM_BLOCKS>
+  struct Unrolled {
+    template <typename Kernel>
+    static inline void run(const float* input, float* output, const int numChannels, Kernel& kernel) {
+      const T inputs{T::load(&input[BLOCK * WIDTH])};
+      T outputs{kernel(BLOCK, BLOCK * WIDTH, inputs, validMask(numChannels, BLOCK))};
+      outputs.store(&output[BLOCK * WIDTH]);
+      Unrolled<BLOCK + 1, NUM_BLOCKS>::run(input, output, numChannels, kernel);
+    }
+  };
+
+  template <int NUM_BLOCKS>
+  struct Unrolled<NUM_BLOCKS, NUM_BLOCKS> {
+    template <typename Kernel>
+    static inline void run(const float*, float*, const int, Kernel&) {}
+  };
+};
+
+}  // namespace DANT
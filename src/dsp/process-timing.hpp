@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min
+#include <atomic>
+#include <cstdint>
+
+#include "cache-line.hpp"
+
+#if defined(DANT_PERF_TIMING)
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>  // __rdtsc
+#endif
+#endif
+
+namespace DANT {
+
+static const int TIMING_STEPS{4};  // buckets per octave, ~19% resolution
+static const int TIMING_OCTAVES{40};
+static const int TIMING_BUCKETS{TIMING_OCTAVES * TIMING_STEPS};
+
+// bucket for a duration, exact below TIMING_STEPS ticks, then TIMING_STEPS log spaced buckets per octave
+inline int timingBucket(const uint64_t ticks) {
+  if (ticks < static_cast<uint64_t>(TIMING_STEPS)) {
+    return static_cast<int>(ticks);
+  }
+  const int msb{63 - __builtin_clzll(ticks)};
+  const int step{static_cast<int>((ticks >> (msb - 2)) & 3u)};
+  const int bucket{((msb - 1) * TIMING_STEPS) + step};
+  return bucket < TIMING_BUCKETS ? bucket : TIMING_BUCKETS - 1;
+}
+
+// first duration in a bucket
+inline uint64_t timingBucketStart(const int bucket) {
+  if (bucket < TIMING_STEPS) {
+    return static_cast<uint64_t>(bucket);
+  }
+  const int msb{(bucket / TIMING_STEPS) + 1};
+  return static_cast<uint64_t>(TIMING_STEPS + (bucket % TIMING_STEPS)) << (msb - 2);
+}
+
+/**
+ * Log bucketed histogram of durations in ticks.
+ * Single writer, the audio thread records without locks or read-modify-write atomics, any thread can read.
+ * A reset requested by a reader is carried out by the writer on its next record.
+ * Starts on its own cache line, so the module state around it isn't invalidated by a reader.
+ */
+struct alignas(DANT::CACHE_LINE) TimingHistogram {
+  TimingHistogram() { clear(); }
+
+  void record(const uint64_t ticks) {
+    if (this->resetRequested.load(std::memory_order_acquire)) {
+      clear();
+      this->resetRequested.store(false, std::memory_order_release);
+    }
+    std::atomic<uint32_t>& bucket = this->buckets[timingBucket(ticks)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+    this->calls.store(this->calls.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+    if (ticks > this->maxTicks.load(std::memory_order_relaxed)) {
+      this->maxTicks.store(ticks, std::memory_order_relaxed);
+    }
+  }
+
+  void requestReset() { this->resetRequested.store(true, std::memory_order_release); }
+
+  uint64_t getCalls() const { return this->calls.load(std::memory_order_relaxed); }
+
+  uint64_t getMaxTicks() const { return this->maxTicks.load(std::memory_order_relaxed); }
+
+  // upper bound of the bucket holding the quantile, q in [0, 1], 0 when nothing was recorded
+  uint64_t quantileTicks(const double q) const {
+    uint32_t counts[TIMING_BUCKETS];
+    uint64_t total{0u};
+    for (int b{0}; b < TIMING_BUCKETS; ++b) {
+      counts[b] = this->buckets[b].load(std::memory_order_relaxed);
+      total += counts[b];
+    }
+    if (total == 0u) {
+      return 0u;
+    }
+    const uint64_t rank{std::max<uint64_t>(1u, static_cast<uint64_t>(q * static_cast<double>(total) + 0.5))};
+    uint64_t seen{0u};
+    for (int b{0}; b < TIMING_BUCKETS - 1; ++b) {
+      seen += counts[b];
+      if (seen >= rank) {
+        return std::min(timingBucketStart(b + 1) - 1u, getMaxTicks());
+      }
+    }
+    return getMaxTicks();
+  }
+
+ private:
+  std::atomic<uint32_t> buckets[TIMING_BUCKETS];
+  std::atomic<uint64_t> calls;
+  std::atomic<uint64_t> maxTicks;
+  std::atomic<bool> resetRequested{false};
+
+  void clear() {
+    for (std::atomic<uint32_t>& bucket : this->buckets) {
+      bucket.store(0u, std::memory_order_relaxed);
+    }
+    this->calls.store(0u, std::memory_order_relaxed);
+    this->maxTicks.store(0u, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * Per call timings of a module's process(), in ns.
+ */
+struct TimingStats {
+  uint64_t calls{0u};
+  double p50Ns{0.0};
+  double p99Ns{0.0};
+  double maxNs{0.0};
+};
+
+#if defined(DANT_PERF_TIMING)
+
+// cheapest monotonic tick counter, the TSC on x86
+inline uint64_t readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t ticks;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
+/**
+ * Converts ticks to ns, calibrated against the steady clock since the first call.
+ * The longer the plugin has been running, the more accurate the ratio.
+ */
+inline double nsPerTick() {
+  struct Origin {
+    uint64_t ticks{readTicks()};
+    std::chrono::steady_clock::time_point time{std::chrono::steady_clock::now()};
+  };
+  static const Origin origin;
+  const uint64_t ticks{readTicks() - origin.ticks};
+  const double ns{static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin.time).count())};
+  return ticks > 0u ? ns / static_cast<double>(ticks) : 1.0;
+}
+
+struct ProcessTiming {
+  TimingHistogram histogram;
+
+  ProcessTiming() { nsPerTick(); }  // start calibrating
+
+  void record(const uint64_t ticks) { this->histogram.record(ticks); }
+
+  void requestReset() { this->histogram.requestReset(); }
+
+  TimingStats read() const {
+    const double scale{nsPerTick()};
+    TimingStats stats;
+    stats.calls = this->histogram.getCalls();
+    stats.p50Ns = static_cast<double>(this->histogram.quantileTicks(0.5)) * scale;
+    stats.p99Ns = static_cast<double>(this->histogram.quantileTicks(0.99)) * scale;
+    stats.maxNs = static_cast<double>(this->histogram.getMaxTicks()) * scale;
+    return stats;
+  }
+};
+
+// times its scope, construct one at the top of process()
+struct ProcessTimer {
+  explicit ProcessTimer(ProcessTiming& timing) : timing(timing), start(readTicks()) {}
+
+  ~ProcessTimer() { this->timing.record(readTicks() - this->start); }
+
+ private:
+  ProcessTiming& timing;
+  const uint64_t start;
+};
+
+#else
+
+// timing disabled, build with DANT_PERF_TIMING defined to enable it, these compile to nothing
+struct ProcessTiming {
+  void requestReset() {}
+  TimingStats read() const { return TimingStats{}; }
+};
+
+struct ProcessTimer {
+  explicit ProcessTimer(ProcessTiming& timing) {}
+};
+
+#endif
+
+/**
+ * Mixin for modules that time their process(), found by the common widget code with a dynamic_cast.
+ * Empty when timing is disabled.
+ */
+struct ProcessTimed {
+  DANT::ProcessTiming processTiming;
+};
+
+}  // namespace DANT
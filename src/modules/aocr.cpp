@@ -1,12 +1,24 @@
-#include <algorithm>  // std::copy std::fill
+#include <algorithm>  // std::copy
+#include <atomic>
 #include <string>
 
 #include "../dsp/att-off-clip-rect.hpp"
+#include "../dsp/cache-line.hpp"
+#include "../dsp/mono-block.hpp"
+#include "../dsp/poly-meter.hpp"
+#include "../dsp/poly-processor.hpp"
+#include "../dsp/process-timing.hpp"
 #include "../plugin.hpp"
 #include "../shared/grid-light.hpp"
 #include "../shared/knob.hpp"
+#include "../shared/capture.hpp"
+#include "../shared/chain-menu.hpp"
+#include "../shared/eco-mode.hpp"
+#include "../shared/expander-chain.hpp"
 #include "../shared/module-widget.hpp"
+#include "../shared/mono-block-menu.hpp"
 #include "../shared/port.hpp"
+#include "../shared/snapshot.hpp"
 #include "../shared/trimpot.hpp"
 
 /**
@@ -19,53 +31,18 @@ const int HP{5};
  */
 struct OpOrderQuantity : rack::ParamQuantity {
   std::string getDisplayValueString() override {
-    switch (static_cast<int>(getDisplayValue())) {
-      case 0:
-        return "AOCR";
-        break;
-      case 1:
-        return "ACOR";
-        break;
-      case 2:
-        return "ACRO";
-        break;
-      case 3:
-        return "OACR";
-        break;
-      case 4:
-        return "OCAR";
-        break;
-      case 5:
-        return "OCRA";
-        break;
-      case 6:
-        return "CAOR";
-        break;
-      case 7:
-        return "CARO";
-        break;
-      case 8:
-        return "COAR";
-        break;
-      case 9:
-        return "CORA";
-        break;
-      case 10:
-        return "CRAO";
-        break;
-      case 11:
-        return "CROA";
-        break;
-      default:
-        return "Unknown";
+    const int order{static_cast<int>(getDisplayValue())};
+    if (order < 0 || order >= DANT::NUM_OP_ORDERS) {
+      return "Unknown";
     }
+    return DANT::OP_ORDER_NAMES[order];
   }
 };
 
 /**
  * Module: audio thread.
  */
-struct AocrModule : rack::engine::Module {
+struct AocrModule : rack::engine::Module, DANT::ProcessTimed, DANT::Captured, DANT::Chained, DANT::CacheAligned {
   enum ParamIds {      // presets use param index
     ORDER_PARAM,       // param 0
     ATV_PARAM,         // param 1
@@ -81,9 +58,22 @@ struct AocrModule : rack::engine::Module {
   enum OutputIds { SGNL_OUTPUT, NUM_OUTPUTS };
   enum LightIds { NUM_LIGHTS };
 
-  int inputSignalNumChannels{0};
-  rack::simd::float_4 inputSignalGridLights[DANT::SIMD];
-  rack::simd::float_4 outputSignalGridLights[DANT::SIMD];
+  std::atomic<bool> monoBlockMode{false};  // mono block mode, set from the context menu
+
+  // read by the UI thread, each on cache lines of its own
+  DANT::Snapshot<DANT::GridLightState> inputGridSnapshot;
+  DANT::Snapshot<DANT::GridLightState> outputGridSnapshot;
+  DANT::Snapshot<DANT::CvState> cvSnapshot;
+
+  // audio thread state, written every sample, starts on a cache line after everything other threads touch
+  alignas(DANT::CACHE_LINE) DANT::EcoMode eco;
+  rack::dsp::ClockDivider snapshotDivider;
+  DANT::AOCROpts processOptions;  // read from the params and CVs, at control rate in Eco mode
+  DANT::ChannelPathSelector channelPath;
+  DANT::PolyMeter inputMeter;
+  DANT::PolyMeter outputMeter;
+  int meteredSamples{0};  // samples metered since the last snapshot
+  DANT::MonoBlock monoBlock;
 
   /**
    * Module constructor.
@@ -114,6 +104,9 @@ struct AocrModule : rack::engine::Module {
     rack::engine::Module::configOutput(SGNL_OUTPUT, "[Poly] Signal");
 
     rack::engine::Module::configBypass(SGNL_INPUT, SGNL_OUTPUT);
+
+    snapshotDivider.setDivision(DANT::SNAPSHOT_DIVISION);
+    chain.attach(*this);
   }
 
   /**
@@ -128,6 +121,8 @@ struct AocrModule : rack::engine::Module {
     DANT::saveUserSettings();
 
     json_t* rootJ = json_object();
+    json_object_set_new(rootJ, "monoBlockMode", json_boolean(monoBlockMode.load()));
+    json_object_set_new(rootJ, "chainEnabled", json_boolean(chain.isEnabled()));
 
     return rootJ;
   }
@@ -135,7 +130,16 @@ struct AocrModule : rack::engine::Module {
   /**
    * Called when module is loaded, sets non-parameter module data.
    */
-  void dataFromJson(json_t* rootJ) override { DANT::loadUserSettings(); }
+  void dataFromJson(json_t* rootJ) override {
+    DANT::loadUserSettings();
+
+    if (json_t* j = json_object_get(rootJ, "monoBlockMode")) {
+      monoBlockMode.store(json_boolean_value(j));
+    }
+    if (json_t* j = json_object_get(rootJ, "chainEnabled")) {
+      chain.setEnabled(json_boolean_value(j));
+    }
+  }
 
   /**
    * Called when a preset is loaded.
@@ -147,6 +151,11 @@ struct AocrModule : rack::engine::Module {
    */
   void onSampleRateChange() override {}
 
+  /**
+   * Called when a module is placed next to this one or removed.
+   */
+  void onExpanderChange(const ExpanderChangeEvent& e) override { chain.link(*this); }
+
   /**
    * Called on module randomise.
    */
@@ -159,6 +168,8 @@ struct AocrModule : rack::engine::Module {
    */
   void onReset() override {
     softReset();
+    monoBlockMode.store(false);
+    chain.setEnabled(false);
 
     rack::engine::Module::onReset();
   }
@@ -167,87 +178,123 @@ struct AocrModule : rack::engine::Module {
    * Can be called to reset non-parameter data.
    */
   void softReset() {
-    inputSignalNumChannels = 0;
-    resetArrays();
-  }
-
-  void resetArrays() {
-    std::fill(inputSignalGridLights, inputSignalGridLights + DANT::SIMD, DANT::SIMD_ZERO);
-    std::fill(outputSignalGridLights, outputSignalGridLights + DANT::SIMD, DANT::SIMD_ZERO);
+    snapshotDivider.reset();
+    inputMeter.reset();
+    outputMeter.reset();
+    meteredSamples = 0;
+    monoBlock.reset();
+    inputGridSnapshot.publish(DANT::GridLightState());
+    outputGridSnapshot.publish(DANT::GridLightState());
   }
 
   /**
    * Called every sample, run DSP code.
    */
   void process(const rack::engine::Module::ProcessArgs& args) override {
-    inputSignalNumChannels = inputs[SGNL_INPUT].getChannels();
+    DANT::ProcessTimer timer{processTiming};  // nothing unless built with DANT_PERF_TIMING
+    // a chained module's signal when unpatched, captured in place of the input so a replay processes the same signal
+    rack::engine::Input& signalInput{chain.input(*this, inputs[SGNL_INPUT])};
+    capture.record(*this, SGNL_INPUT, &signalInput);  // nothing unless capturing, developer mode only
 
-    DANT::AOCROpts processOptions;
-    processOptions.opOrder = readOrdering();
-    processOptions.attenuversion = readAttenuverter();
-    processOptions.offset = readOffset();
-    processOptions.clipLvl = readClipping();
-    processOptions.rectLvl = readRectification();
-    processOptions.rectType = readRectifyType();
+    if (eco.update()) {
+      snapshotDivider.setDivision(eco.snapshotDivision());
+    }
 
-    for (int c{0}; c < inputSignalNumChannels; c += DANT::SIMD) {
-      rack::simd::float_4 inputSignals = inputs[SGNL_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
-      inputSignalGridLights[DANT::SIMD_I[c]] = inputSignals;
+    const int inputSignalNumChannels{signalInput.getChannels()};
 
-      rack::simd::float_4 processedVals = DANT::attenuvertOffsetClipRectify(inputSignals, processOptions);
+    // every sample, or every ECO_CV_DIVISION samples in Eco mode, when the CVs are read and the signals metered
+    const bool controlFrame{eco.readCvs()};
+    if (controlFrame) {
+      processOptions = readOptions();
+    }
 
-      outputSignalGridLights[DANT::SIMD_I[c]] = processedVals;
-      outputs[SGNL_OUTPUT].setVoltageSimd<rack::simd::float_4>(processedVals, c);
+    const DANT::CHANNEL_PATH path{channelPath.select(inputSignalNumChannels)};
+    const bool blockMode{path == DANT::MONO_CHANS && monoBlockMode.load()};
+    if (blockMode != monoBlock.isEnabled()) {
+      monoBlock.setEnabled(blockMode);
+    }
+
+    if (monoBlock.isEnabled()) {
+      const float processedVal{monoBlock.process(signalInput.getVoltage(), [&](const rack::simd::float_4 inputFrames) {
+        rack::simd::float_4 processedFrames = DANT::attenuvertOffsetClipRectify(inputFrames, processOptions);
+
+        // already once per 4 frames, so metered in Eco mode too
+        inputMeter.processMonoFrames(inputFrames);
+        outputMeter.processMonoFrames(processedFrames);
+        meteredSamples += DANT::MONO_BLOCK_FRAMES;
+        return processedFrames;
+      })};
+      outputs[SGNL_OUTPUT].setVoltage(processedVal);
+      outputs[SGNL_OUTPUT].setChannels(1);
+    } else if (path == DANT::MONO_CHANS) {
+      DANT::PolyProcessor<>::processMono(signalInput, outputs[SGNL_OUTPUT], [&](const float inputSignal) {
+        return DANT::attenuvertOffsetClipRectify(inputSignal, processOptions);
+      });
+      if (controlFrame) {
+        inputMeter.processMono(signalInput.voltages[0]);
+        outputMeter.processMono(outputs[SGNL_OUTPUT].voltages[0]);
+        ++meteredSamples;
+      }
+    } else {
+      meteredSamples += controlFrame ? 1 : 0;
+      DANT::PolyProcessor<>::process(
+          path, signalInput, outputs[SGNL_OUTPUT], inputSignalNumChannels,
+          [&](const int block, const int c, const rack::simd::float_4 inputSignals,
+              const rack::simd::float_4 validMask) {
+            rack::simd::float_4 processedVals = DANT::attenuvertOffsetClipRectify(inputSignals, processOptions);
+
+            if (controlFrame) {
+              inputMeter.process(inputSignals, block);
+              outputMeter.process(processedVals, block);
+            }
+            return processedVals;
+          });
     }
 
-    outputs[SGNL_OUTPUT].setChannels(inputSignalNumChannels);
+    if (snapshotDivider.process()) {
+      publishGridSnapshot(inputMeter, inputGridSnapshot, inputSignalNumChannels);
+      publishGridSnapshot(outputMeter, outputGridSnapshot, inputSignalNumChannels);
+      meteredSamples = 0;
+      publishCvSnapshot();
+    }
+    chain.send(*this, outputs[SGNL_OUTPUT]);
   }
 
-  // converts between parameter int value and dsp code enum
-  inline DANT::OP_ORDER readOrdering() {
-    switch (static_cast<int>(params[ORDER_PARAM].getValue())) {
-      case 0:
-        return DANT::OP_ORDER::AOCR;
-        break;
-      case 1:
-        return DANT::OP_ORDER::ACOR;
-        break;
-      case 2:
-        return DANT::OP_ORDER::ACRO;
-        break;
-      case 3:
-        return DANT::OP_ORDER::OACR;
-        break;
-      case 4:
-        return DANT::OP_ORDER::OCAR;
-        break;
-      case 5:
-        return DANT::OP_ORDER::OCRA;
-        break;
-      case 6:
-        return DANT::OP_ORDER::CAOR;
-        break;
-      case 7:
-        return DANT::OP_ORDER::CARO;
-        break;
-      case 8:
-        return DANT::OP_ORDER::COAR;
-        break;
-      case 9:
-        return DANT::OP_ORDER::CORA;
-        break;
-      case 10:
-        return DANT::OP_ORDER::CRAO;
-        break;
-      case 11:
-        return DANT::OP_ORDER::CROA;
-        break;
-      default:
-        return DANT::OP_ORDER::AOCR;
-        break;
+  // reduces the meter over the last snapshot interval and publishes the peaks and RMS
+  inline void publishGridSnapshot(DANT::PolyMeter& meter, DANT::Snapshot<DANT::GridLightState>& snapshot,
+                                  const int numChannels) {
+    meter.reduce(meteredSamples);
+    DANT::GridLightState gridLights;
+    gridLights.numChannels = numChannels;
+    std::copy(meter.peak, meter.peak + DANT::SIMD, gridLights.peak);
+    std::copy(meter.rms, meter.rms + DANT::SIMD, gridLights.rms);
+    snapshot.publish(gridLights);
+  }
+
+  // copies the first channel of every input for the knob CV visualisations
+  inline void publishCvSnapshot() {
+    static_assert(NUM_INPUTS <= DANT::CHANS, "CvState holds one voltage per input");
+    DANT::CvState cvState;
+    for (int i{0}; i < NUM_INPUTS; ++i) {
+      cvState.voltages[i] = inputs[i].getNormalVoltage(0.0f);
     }
+    cvSnapshot.publish(cvState);
+  }
+
+  inline DANT::AOCROpts readOptions() {
+    DANT::AOCROpts options;
+    options.opOrder = readOrdering();
+    options.attenuversion = readAttenuverter();
+    options.offset = readOffset();
+    options.clipLvl = readClipping();
+    options.rectLvl = readRectification();
+    options.rectType = readRectifyType();
+    return options;
   }
 
+  // converts between parameter int value and dsp code enum
+  inline DANT::OP_ORDER readOrdering() { return DANT::toOpOrder(static_cast<int>(params[ORDER_PARAM].getValue())); }
+
   // calculates the attenuversion value from the parameter plus the attenuverted CV
   inline float readAttenuverter() {
     return params[ATV_PARAM].getValue() +
@@ -312,13 +359,64 @@ struct AocrModule : rack::engine::Module {
   }
 };
 
+static_assert(alignof(AocrModule) == DANT::CACHE_LINE, "AocrModule state is laid out in cache lines");
+
 /**
  * Widgets: UI thread.
  */
+struct OpOrderLetters : rack::widget::Widget {
+  rack::math::Vec positions[DANT::SIMD];  // top right of each letter, columns follow OP_ORDER_NAMES[AOCR]
+
+  void setOrder(const DANT::OP_ORDER order) {
+    for (int column{0}; column < DANT::SIMD; ++column) {
+      const int step{DANT::opStep(order, DANT::OP_ORDER_NAMES[DANT::OP_ORDER::AOCR][column])};
+      this->positions[column] = rack::math::Vec((this->box.size.x * 0.25f) * (column + 1.0f),
+                                                (this->box.size.y * 0.2f) * (step + 1.0f));
+    }
+  }
+
+  void draw(const rack::widget::Widget::DrawArgs& args) override {
+    DANT::Fonts::DrawOptions opts;
+    opts.align = NVG_ALIGN_TOP | NVG_ALIGN_RIGHT;
+    opts.ttfFile = DANT::REGULAR_TTF;
+    opts.size = 9.0f;
+    opts.colour = DANT::RGB_CV_YELLOW;
+
+    for (int column{0}; column < DANT::SIMD; ++column) {
+      opts.xpos = this->positions[column].x;
+      opts.ypos = this->positions[column].y;
+      DANT::Fonts::drawText(args, std::string(1, DANT::OP_ORDER_NAMES[DANT::OP_ORDER::AOCR][column]), opts);
+    }
+  }
+};
+
 struct OpOrderWidget : rack::widget::TransparentWidget {
   AocrModule* module;
+  rack::widget::FramebufferWidget* lettersFb;
+  OpOrderLetters* letters;
+  int cachedOrder{-1};  // order the letters framebuffer was rendered for
+
+  OpOrderWidget(AocrModule* m) {
+    this->module = m;
+    this->lettersFb = new rack::widget::FramebufferWidget;
+    this->letters = new OpOrderLetters;
+    this->lettersFb->addChild(this->letters);
+    addChild(this->lettersFb);
+  }
 
-  OpOrderWidget(AocrModule* m) { this->module = m; }
+  void step() override {
+    this->lettersFb->box.size = this->box.size;
+    this->letters->box.size = this->box.size;
+
+    const DANT::OP_ORDER currentOrder{this->module ? this->module->readOrdering() : DANT::OP_ORDER::AOCR};
+    if (currentOrder != this->cachedOrder) {
+      this->cachedOrder = currentOrder;
+      this->letters->setOrder(currentOrder);
+      this->lettersFb->setDirty();
+    }
+
+    rack::widget::TransparentWidget::step();
+  }
 
   void draw(const rack::widget::Widget::DrawArgs& args) override {
     nvgSave(args.vg);
@@ -363,193 +461,8 @@ struct OpOrderWidget : rack::widget::TransparentWidget {
 
   void drawLayer(const rack::widget::Widget::DrawArgs& args, int layer) override {
     if (layer == 1) {
-      nvgSave(args.vg);
-
-      DANT::Fonts::DrawOptions opts;
-      opts.align = NVG_ALIGN_TOP | NVG_ALIGN_RIGHT;
-      opts.ttfFile = DANT::REGULAR_TTF;
-      opts.size = 9.0f;
-      opts.colour = DANT::RGB_CV_YELLOW;
-
-      DANT::OP_ORDER currentOrder = DANT::OP_ORDER::AOCR;
-      if (module) {
-        currentOrder = module->readOrdering();
-      }
-
-      switch (currentOrder) {
-        case DANT::OP_ORDER::AOCR:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::ACOR:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::ACRO:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::OACR:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::OCAR:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::OCRA:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::CAOR:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::CARO:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::COAR:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::CORA:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::CRAO:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        case DANT::OP_ORDER::CROA:
-          opts.xpos = (this->box.size.x * 0.25f) * 1.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 4.0f;
-          DANT::Fonts::drawText(args, "A", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 2.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 3.0f;
-          DANT::Fonts::drawText(args, "O", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 3.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 1.0f;
-          DANT::Fonts::drawText(args, "C", opts);
-          opts.xpos = (this->box.size.x * 0.25f) * 4.0f;
-          opts.ypos = (this->box.size.y * 0.2f) * 2.0f;
-          DANT::Fonts::drawText(args, "R", opts);
-          break;
-        default:
-          break;
-      }
-
-      nvgRestore(args.vg);
+      // letters only change with the order param, paint the cached framebuffer on the light layer
+      this->lettersFb->draw(args);
     }
     rack::widget::Widget::drawLayer(args, layer);
   }
@@ -596,8 +509,7 @@ struct AocrWidget : DANT::ModuleWidget {
     signalInGridLight = rack::createWidgetCentered<DANT::GridLight>(DANT::layout(4.5f, 2.0f));
     signalInGridLight->fullMode();
     if (module) {
-      signalInGridLight->numChannels = &module->inputSignalNumChannels;
-      signalInGridLight->channelValues = module->inputSignalGridLights;  // array decays into pointer to 1st element
+      signalInGridLight->snapshot = &module->inputGridSnapshot;
     }
 
     orderKnob = rack::createParamCentered<DANT::Knob>(DANT::layout(3.0f, 5.0f), module, AocrModule::ORDER_PARAM);
@@ -608,6 +520,9 @@ struct AocrWidget : DANT::ModuleWidget {
     attenuverterKnob->vizType = DANT::KnobViz::BIPARC;
     attenuverterKnob->inputId = AocrModule::ATV_CV_INPUT;
     attenuverterKnob->cvAttId = AocrModule::ATV_CV_ATV_PARAM;
+    if (module) {
+      attenuverterKnob->cvSnapshot = &module->cvSnapshot;
+    }
 
     attenuverterCvTrimpot =
         rack::createParamCentered<DANT::Trimpot>(DANT::layout(4.0f, 6.0f), module, AocrModule::ATV_CV_ATV_PARAM);
@@ -620,6 +535,9 @@ struct AocrWidget : DANT::ModuleWidget {
     offsetKnob->numNotches = 3;
     offsetKnob->inputId = AocrModule::OFS_CV_INPUT;
     offsetKnob->cvAttId = AocrModule::OFS_CV_ATV_PARAM;
+    if (module) {
+      offsetKnob->cvSnapshot = &module->cvSnapshot;
+    }
 
     offsetCvTrimpot =
         rack::createParamCentered<DANT::Trimpot>(DANT::layout(2.0f, 9.0f), module, AocrModule::OFS_CV_ATV_PARAM);
@@ -638,8 +556,7 @@ struct AocrWidget : DANT::ModuleWidget {
     signalOutGridLight = rack::createWidgetCentered<DANT::GridLight>(DANT::layout(1.5f, 15.0f));
     signalOutGridLight->fullMode();
     if (module) {
-      signalOutGridLight->numChannels = &module->inputSignalNumChannels;
-      signalOutGridLight->channelValues = module->outputSignalGridLights;  // array decays into pointer to 1st element
+      signalOutGridLight->snapshot = &module->outputGridSnapshot;
     }
 
     testOutputPort = rack::createOutputCentered<DANT::Port>(DANT::layout(3.0f, 15.0f), module, AocrModule::SGNL_OUTPUT);
@@ -665,10 +582,18 @@ struct AocrWidget : DANT::ModuleWidget {
   // used by the common code to draw the module title
   std::string moduleName() override { return "AOCR"; }
 
-  void draw(const rack::widget::Widget::DrawArgs& args) override {
-    DANT::ModuleWidget::draw(args);  // call common draw method for panel first
+  void appendContextMenu(rack::ui::Menu* menu) override {
+    DANT::ModuleWidget::appendContextMenu(menu);
+    AocrModule* module = dynamic_cast<AocrModule*>(this->module);
+    if (!module) return;
+    menu->addChild(new rack::ui::MenuSeparator);
+    DANT::appendChainMenu(menu, &module->chain);
+    DANT::appendMonoBlockMenu(
+        menu, [=]() { return module->monoBlockMode.load(); }, [=](bool value) { module->monoBlockMode.store(value); });
+  }
 
-    // now draw on top of the panel
+  // drawn on top of the panel by the common draw method
+  void drawPanelLabels(const rack::widget::Widget::DrawArgs& args) override {
     DANT::Fonts::DrawOptions opts;
     opts.align = NVG_ALIGN_MIDDLE | NVG_ALIGN_CENTER;
     opts.size = 20.0f;
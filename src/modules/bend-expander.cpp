@@ -0,0 +1,142 @@
+#include <string>
+
+#include "../dsp/cache-line.hpp"
+#include "../dsp/lane-mask.hpp"
+#include "../dsp/process-timing.hpp"
+#include "../plugin.hpp"
+#include "../shared/bend-poly-state.hpp"
+#include "../shared/module-widget.hpp"
+#include "../shared/port.hpp"
+
+/**
+ * Constant values.
+ */
+const int BEND_EXPANDER_HP{5};
+const float GATE_VOLTS{10.0f};
+const float END_TRIGGER_SECONDS{1e-3f};
+
+/**
+ * Module: audio thread.
+ * Outputs the state of the Bend placed directly to its left, one channel per Bend channel.
+ */
+struct BendExpanderModule : rack::engine::Module, DANT::ProcessTimed, DANT::BendStateReader, DANT::CacheAligned {
+  enum ParamIds { NUM_PARAMS };
+  enum InputIds { NUM_INPUTS };
+  enum OutputIds {
+    PROGRESS_OUTPUT,   // 0V to 10V through each bend and unbend
+    ENVELOPE_OUTPUT,   // 0V to 10V along the bend's curve
+    BENDING_OUTPUT,    // 10V gate
+    HOLDING_OUTPUT,    // 10V gate
+    UNBENDING_OUTPUT,  // 10V gate
+    END_OUTPUT,        // 1ms 10V trigger when a bend has ended
+    NUM_OUTPUTS
+  };
+  enum LightIds { NUM_LIGHTS };
+
+  // audio thread state, written every sample
+  alignas(DANT::CACHE_LINE) rack::simd::float_4 endTimers[DANT::SIMD]{};  // seconds left of each end trigger
+
+  /**
+   * Module constructor.
+   */
+  BendExpanderModule() {
+    rack::engine::Module::config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
+
+    rack::engine::Module::configOutput(PROGRESS_OUTPUT, "[Poly] Bend progress");
+    rack::engine::Module::configOutput(ENVELOPE_OUTPUT, "[Poly] Bend envelope");
+    rack::engine::Module::configOutput(BENDING_OUTPUT, "[Poly] Bending gate");
+    rack::engine::Module::configOutput(HOLDING_OUTPUT, "[Poly] Holding gate");
+    rack::engine::Module::configOutput(UNBENDING_OUTPUT, "[Poly] Unbending gate");
+    rack::engine::Module::configOutput(END_OUTPUT, "[Poly] End of bend trigger");
+
+    attachBendState(*this);
+  }
+
+  /**
+   * Called when a module is placed next to this one or removed.
+   */
+  void onExpanderChange(const ExpanderChangeEvent& e) override {
+    if (e.side == 0) {
+      clearBendState();
+    }
+  }
+
+  /**
+   * Called for module initialisation, can be called to manually reset params.
+   */
+  void onReset() override {
+    for (rack::simd::float_4& timer : endTimers) {
+      timer = rack::simd::float_4::zero();
+    }
+
+    rack::engine::Module::onReset();
+  }
+
+  /**
+   * Called every sample, run DSP code.
+   */
+  void process(const rack::engine::Module::ProcessArgs& args) override {
+    DANT::ProcessTimer timer{processTiming};  // nothing unless built with DANT_PERF_TIMING
+
+    const DANT::BendPolyState& state = bendState(*this);
+    const int numChannels{state.channels};
+    for (int block{0}; block < DANT::SIMD; ++block) {
+      const int c{block * DANT::SIMD};
+      // every block's trigger runs out, so one isn't left high while its channel is missing and back when it returns
+      endTimers[block] = rack::simd::ifelse(state.ended.mask(block), END_TRIGGER_SECONDS, endTimers[block]);
+      if (c < numChannels) {
+        outputs[PROGRESS_OUTPUT].setVoltageSimd(state.progress[block] * GATE_VOLTS, c);
+        outputs[ENVELOPE_OUTPUT].setVoltageSimd(state.envelope[block] * GATE_VOLTS, c);
+        outputs[BENDING_OUTPUT].setVoltageSimd(rack::simd::ifelse(state.bending.mask(block), GATE_VOLTS, 0.0f), c);
+        outputs[HOLDING_OUTPUT].setVoltageSimd(rack::simd::ifelse(state.holding.mask(block), GATE_VOLTS, 0.0f), c);
+        outputs[UNBENDING_OUTPUT].setVoltageSimd(rack::simd::ifelse(state.unbending.mask(block), GATE_VOLTS, 0.0f),
+                                                 c);
+        outputs[END_OUTPUT].setVoltageSimd(rack::simd::ifelse(endTimers[block] > 0.0f, GATE_VOLTS, 0.0f), c);
+      }
+      endTimers[block] = rack::simd::fmax(endTimers[block] - args.sampleTime, 0.0f);
+    }
+    for (rack::engine::Output& output : outputs) {
+      output.setChannels(numChannels);
+    }
+  }
+};
+
+static_assert(alignof(BendExpanderModule) == DANT::CACHE_LINE, "BendExpanderModule state is laid out in cache lines");
+
+/**
+ * Widget: UI thread.
+ */
+struct BendExpanderWidget : DANT::ModuleWidget {
+  std::string moduleName() override { return "BendX"; }
+
+  BendExpanderWidget(BendExpanderModule* module) {
+    rack::app::ModuleWidget::setModule(module);
+    this->box.size = rack::math::Vec(rack::app::RACK_GRID_WIDTH * BEND_EXPANDER_HP, rack::app::RACK_GRID_HEIGHT);
+
+    for (int output{0}; output < BendExpanderModule::NUM_OUTPUTS; ++output) {
+      DANT::Port* port = rack::createOutputCentered<DANT::Port>(DANT::layout(3.0f, 4.0f + (2.0f * output)), module,
+                                                                output);
+      port->isOutput = true;
+      rack::app::ModuleWidget::addOutput(port);
+    }
+  }
+
+  void drawPanelLabels(const rack::widget::Widget::DrawArgs& args) override {
+    static const std::string LABELS[BendExpanderModule::NUM_OUTPUTS]{"Progress", "Envelope", "Bending",
+                                                                     "Holding",  "Unbending", "End"};
+    DANT::Fonts::DrawOptions opts;
+    opts.ttfFile = DANT::REGULAR_TTF;
+    opts.size = 11.0f;
+    opts.align = NVG_ALIGN_MIDDLE | NVG_ALIGN_CENTER;
+    for (int output{0}; output < BendExpanderModule::NUM_OUTPUTS; ++output) {
+      opts.xpos = DANT::layout(3.0f, 3.1f + (2.0f * output)).x;
+      opts.ypos = DANT::layout(3.0f, 3.1f + (2.0f * output)).y;
+      DANT::Fonts::drawText(args, LABELS[output], opts);
+    }
+  }
+};
+
+/**
+ * Create model and register with the plugin.
+ */
+rack::plugin::Model* modelBendExpander = rack::createModel<BendExpanderModule, BendExpanderWidget>("BendExpander");
@@ -1,21 +1,42 @@
+#include <algorithm>  // std::copy
 #include <string>
-#include <vector>
 
 #include "../dsp/bend-voct.hpp"
+#include "../dsp/cache-line.hpp"
+#include "../dsp/clock-follower.hpp"
+#include "../dsp/lane-mask.hpp"
+#include "../dsp/midi-voices.hpp"
+#include "../dsp/mono-block.hpp"
+#include "../dsp/poly-meter.hpp"
+#include "../dsp/process-timing.hpp"
 #include "../plugin.hpp"
+#include "../shared/bend-poly-state.hpp"
 #include "../shared/grid-light.hpp"
 #include "../shared/knob.hpp"
+#include "../shared/capture.hpp"
+#include "../shared/chain-menu.hpp"
+#include "../shared/eco-mode.hpp"
+#include "../shared/expander-chain.hpp"
 #include "../shared/module-widget.hpp"
+#include "../shared/mono-block-menu.hpp"
 #include "../shared/port.hpp"
+#include "../shared/snapshot.hpp"
+#include "../shared/triple-buffer.hpp"
 
 const int HP{8};
+const uint32_t LIGHT_DIVISION{32};  // samples between button light updates
+const float BEAT_SNAP_WINDOW{0.25f};  // share of a beat or division from the predicted grid that snaps to it
 
 struct BeatDivision {
   float multiplier;
-  std::string label;
+  const char* label;
 };
 
-const std::vector<BeatDivision> divisions = {
+// read on the audio thread, a plain array so nothing about it can allocate
+// from the 1/4 note up the multiplier is the beat division value + 1
+const int NUM_DIVISIONS{15};
+const int QUARTER_DIVISION{7};
+const BeatDivision divisions[NUM_DIVISIONS]{
     {0.125f, "1/32"}, {0.166f, "1/16T"}, {0.25f, "1/16"}, {0.333f, "1/8T"}, {0.375f, "1/16."},
     {0.5f, "1/8"},    {0.75f, "1/8."},   {1.0f, "1/4"},   {2.0f, "1/2"},    {3.0f, "1/2."},
     {4.0f, "1/1"},    {5.0f, "5/4"},     {6.0f, "1/1."},  {7.0f, "7/4"},    {8.0f, "2/1"},
@@ -26,15 +47,15 @@ struct BeatDivQuantity : rack::ParamQuantity {
     int val = static_cast<int>(getValue() + (getValue() > 0.0f ? 0.5f : -0.5f));
     if (val >= 0) {
       int beats = val + 1;
-      return divisions[rack::math::clamp(val + 7, 0, 14)].label + " - " + std::to_string(beats) +
-             (beats == 1 ? " Beat" : " Beats");
+      return std::string(divisions[rack::math::clamp(val + 7, 0, NUM_DIVISIONS - 1)].label) + " - " +
+             std::to_string(beats) + (beats == 1 ? " Beat" : " Beats");
     } else {
-      return divisions[rack::math::clamp(val + 7, 0, 14)].label;
+      return divisions[rack::math::clamp(val + 7, 0, NUM_DIVISIONS - 1)].label;
     }
   }
 };
 
-struct BendModule : rack::engine::Module {
+struct BendModule : rack::engine::Module, DANT::ProcessTimed, DANT::Captured, DANT::Chained, DANT::CacheAligned {
   enum ParamIds {
     BEAT_DIV_PARAM,          // param 0 - beat division when in clocked mode
     LENGTH_PARAM,            // param 1 - bend length time when in fixed time mode
@@ -136,262 +157,619 @@ struct BendModule : rack::engine::Module {
     rack::engine::Module::configInput(BEND_TRACKING_CV_INPUT, "[Poly] Input Tracking CV");
 
     rack::engine::Module::configOutput(SIGNALS_OUTPUT, "[Poly] V/Oct Signals");
+
+    snapshotDivider.setDivision(DANT::SNAPSHOT_DIVISION);
+    lightDivider.setDivision(LIGHT_DIVISION);
+    setConfig(BendConfig());
+    chain.attach(*this);
   }
 
-  bool clockedMode{false};
   enum HoldMethod { INDEFINITE = 0, AUTO_UNHOLD = 1, GATE_BENDS = 2, TOGGLE_TRIGGERS = 3 };
-  HoldMethod holdMethod{INDEFINITE};
-  float autoUnholdThreshold{0.0f};
-  bool unbendEnvelope{false};
-  bool inverseUnbendShape{false};
-  float unbendDurationPct{0.10f};
-  int gridLightChannels{0};
-  rack::simd::float_4 gridLightValues[DANT::SIMD];
-  float clockTimer{0.0f};
-  float clockPeriod{0.0f};
-  rack::dsp::SchmittTrigger clockTrigger;
-  struct BendPolyState {
-    rack::simd::float_4 active = rack::simd::float_4::zero();
-    rack::simd::float_4 isUnbending = rack::simd::float_4::zero();
-    rack::simd::float_4 startOffset = rack::simd::float_4::zero();
-    rack::simd::float_4 targetOffset = rack::simd::float_4::zero();
-    rack::simd::float_4 elapsedSeconds = rack::simd::float_4::zero();
-    rack::simd::float_4 totalSeconds = rack::simd::float_4::zero();
-    rack::simd::float_4 sampledInputPitch = rack::simd::float_4::zero();
-    rack::simd::float_4 isUp = rack::simd::float_4::zero();
+
+  // context menu settings, set with setConfig on the UI thread and taken by the audio thread at the next sample
+  struct BendConfig {
+    HoldMethod holdMethod{INDEFINITE};
+    float autoUnholdThreshold{0.0f};  // volts
+    bool unbendEnvelope{false};
+    bool inverseUnbendShape{false};
+    float unbendDurationPct{0.10f};
+    bool subSampleOnset{false};  // bends start between samples, where the trigger crossed its threshold
+    bool midiEnabled{false};     // pitch and triggers from the MIDI input's notes instead of the ports
+    int midiVoices{1};
+    bool wheelToAmount{false};       // the pitch wheel adds up to ±12 semitones to the bend amount
+    bool aftertouchToAmount{false};  // aftertouch adds up to 12 semitones to the bend amount
+    bool monoBlockMode{false};       // mono signals are bent 4 frames at a time
+    bool snapToBeat{false};          // clocked bends end on the predicted beat, as if triggered on it
   };
-  BendPolyState bendStates[4];
+  DANT::TripleBuffer<BendConfig> configBuffer;
+  rack::midi::InputQueue midiInput;  // filled by Rack's MIDI thread, driver and device set from the context menu
 
-  rack::dsp::SchmittTrigger resetTriggerDetectors[DANT::CHANS];
-  rack::dsp::SchmittTrigger bendTriggerDetectors[DANT::CHANS];
+  // read by the UI thread, each on cache lines of its own
+  DANT::Snapshot<DANT::GridLightState> gridSnapshot;
+  DANT::Snapshot<DANT::CvState> cvSnapshot;
+
+  // continuous per lane bend state, one float_4 per block of 4 channels, so each field fills one cache line
+  struct alignas(DANT::CACHE_LINE) BendLanes {
+    rack::simd::float_4 startOffset[DANT::SIMD]{};
+    rack::simd::float_4 targetOffset[DANT::SIMD]{};
+    rack::simd::float_4 elapsedSeconds[DANT::SIMD]{};
+    rack::simd::float_4 totalSeconds[DANT::SIMD]{};
+    rack::simd::float_4 sampledInputPitch[DANT::SIMD]{};
+    rack::simd::float_4 unbendFrom[DANT::SIMD]{};  // the bend's envelope when its unbend started
+  };
+
+  // Eco mode's control rate copies of the CVs advanceBend reads for every active block
+  struct alignas(DANT::CACHE_LINE) ControlRateCvs {
+    rack::simd::float_4 tracking[DANT::SIMD]{};
+    rack::simd::float_4 shape[DANT::SIMD]{};
+    rack::simd::float_4 completion[DANT::SIMD]{};
+  };
+
+  // audio thread state, written every sample, starts on a cache line after everything other threads touch
+  alignas(DANT::CACHE_LINE) DANT::EcoMode eco;
+  bool clockedMode{false};
+  DANT::ClockFollower clockFollower;
+  float clockDurations[NUM_DIVISIONS]{};  // the clock period times each division's multiplier
+  rack::dsp::ClockDivider snapshotDivider;
+  rack::dsp::ClockDivider lightDivider;
+  rack::simd::float_4 resetPeak{};    // highest reset voltage per lane since the last light update
+  rack::simd::float_4 bendTrigPeak{};  // highest bend trigger voltage per lane since the last light update
+  BendConfig config;                         // the audio thread's copy of the settings
+  rack::simd::float_4 unbendDurationScale{};  // derived from config, unbend duration as a fraction of the bend
+  rack::simd::float_4 autoUnholdVolts{};      // derived from config
+  DANT::TriggerLanes resetTriggers;
+  DANT::TriggerLanes bendTriggers;
+  rack::simd::float_4 previousBendTriggers[DANT::SIMD]{};  // last sample's trigger inputs, for sub-sample onsets
+  DANT::LaneMask activeLanes;     // bending or unbending
+  DANT::LaneMask unbendingLanes;  // returning to the input pitch
+  DANT::LaneMask upLanes;         // bending up, the sign of the intensity lights
+  BendLanes lanes;
+  ControlRateCvs controlCvs;
+  DANT::MidiVoices midi;
+  rack::midi::Message midiMessage;  // popped into, so taking a message never allocates
+  rack::engine::Input midiPitch;    // the voices' pitch and gates, read in place of the ports when MIDI is enabled
+  rack::engine::Input midiGates;
+  DANT::PolyMeter intensityMeter;
+  bool meterFrame{true};  // the intensity is metered this frame, every frame unless in Eco mode
+  int meteredFrames{0};  // frames metered since the last snapshot
+  DANT::MonoBlock monoBlock;
+  bool stateReaderRight{false};  // a module reading Bend's state is placed on the right
+  DANT::BendPolyState bendState;  // written as the blocks advance, kept between blocks, sent whole every sample
+  DANT::LaneMask stateActive;     // the active lanes last sent, for the ended lanes
 
   void softReset(int channel = -1) {
     if (channel == -1) {
       clockedMode = false;
-      for (int i = 0; i < 4; ++i) {
-        bendStates[i].active = rack::simd::float_4::zero();
-        bendStates[i].isUnbending = rack::simd::float_4::zero();
-        bendStates[i].startOffset = rack::simd::float_4::zero();
-        bendStates[i].targetOffset = rack::simd::float_4::zero();
-        bendStates[i].elapsedSeconds = rack::simd::float_4::zero();
-        bendStates[i].totalSeconds = {0.0f};
-        bendStates[i].sampledInputPitch = rack::simd::float_4::zero();
-      }
+      activeLanes.clear();
+      unbendingLanes.clear();
+      lanes = BendLanes();
     } else {
       int block = channel / 4;
       int lane = channel % 4;
-      bendStates[block].active[lane] = 0.0f;
-      bendStates[block].isUnbending[lane] = 0.0f;
-      bendStates[block].startOffset[lane] = 0.0f;
-      bendStates[block].targetOffset[lane] = 0.0f;
-      bendStates[block].elapsedSeconds[lane] = 0.0f;
-      bendStates[block].totalSeconds[lane] = 0.0f;
-      bendStates[block].sampledInputPitch[lane] = 0.0f;
-      bendStates[block].isUp[lane] = 0.0f;
+      activeLanes.set(channel, false);
+      unbendingLanes.set(channel, false);
+      lanes.startOffset[block][lane] = 0.0f;
+      lanes.targetOffset[block][lane] = 0.0f;
+      lanes.elapsedSeconds[block][lane] = 0.0f;
+      lanes.totalSeconds[block][lane] = 0.0f;
+      lanes.sampledInputPitch[block][lane] = 0.0f;
+      lanes.unbendFrom[block][lane] = 0.0f;
+      upLanes.set(channel, false);
     }
   }
 
   void onReset() override {
     softReset();
-    unbendEnvelope = false;
-    inverseUnbendShape = false;
-    unbendDurationPct = 0.10f;
-    holdMethod = INDEFINITE;
-    autoUnholdThreshold = 0.0f;
-    for (int c = 0; c < DANT::CHANS; ++c) {
-      resetTriggerDetectors[c].reset();
+    setConfig(BendConfig());
+    chain.setEnabled(false);
+    resetTriggers.reset();
+    clockFollower.reset();
+    midiInput.reset();
+    midi.reset();
+  }
+
+  // a module was placed next to this one or removed
+  void onExpanderChange(const ExpanderChangeEvent& e) override {
+    chain.link(*this);
+    const bool reader{dynamic_cast<DANT::BendStateReader*>(rightExpander.module) != nullptr};
+    if (reader != stateReaderRight) {
+      // so a new reader doesn't start from the state kept for the one before
+      bendState = DANT::BendPolyState();
+      stateActive.clear();
+    }
+    stateReaderRight = reader;
+  }
+
+  // UI thread, the settings as last set
+  const BendConfig& getConfig() const { return configBuffer.latest(); }
+
+  // UI thread, publishes new settings to the audio thread
+  void setConfig(const BendConfig& newConfig) {
+    if (newConfig.midiEnabled && capture.isActive()) {
+      capture.stop();  // notes aren't captured, so what follows couldn't be replayed
     }
+    configBuffer.write(newConfig);
+  }
+
+  // UI thread, MIDI notes, the pitch wheel and aftertouch aren't ports, so a capture couldn't replay them
+  std::string captureBlocked() const override { return getConfig().midiEnabled ? "Not with MIDI" : ""; }
+
+  // UI thread, changes one setting, e.g. setConfigValue(&BendConfig::unbendEnvelope, true)
+  template <typename V>
+  void setConfigValue(V BendConfig::*field, const V value) {
+    BendConfig changed{getConfig()};
+    changed.*field = value;
+    setConfig(changed);
   }
 
   json_t* dataToJson() override {
     json_t* rootJ = json_object();
-    json_object_set_new(rootJ, "unbendEnvelope", json_boolean(unbendEnvelope));
-    json_object_set_new(rootJ, "inverseUnbendShape", json_boolean(inverseUnbendShape));
-    json_object_set_new(rootJ, "unbendDurationPct", json_real(static_cast<double>(unbendDurationPct)));
-    json_object_set_new(rootJ, "holdMethod", json_integer(static_cast<int>(holdMethod)));
-    json_object_set_new(rootJ, "autoUnholdThreshold", json_real(static_cast<double>(autoUnholdThreshold)));
+    const BendConfig& saved = getConfig();
+    json_object_set_new(rootJ, "unbendEnvelope", json_boolean(saved.unbendEnvelope));
+    json_object_set_new(rootJ, "inverseUnbendShape", json_boolean(saved.inverseUnbendShape));
+    json_object_set_new(rootJ, "unbendDurationPct", json_real(static_cast<double>(saved.unbendDurationPct)));
+    json_object_set_new(rootJ, "holdMethod", json_integer(static_cast<int>(saved.holdMethod)));
+    json_object_set_new(rootJ, "autoUnholdThreshold", json_real(static_cast<double>(saved.autoUnholdThreshold)));
+    json_object_set_new(rootJ, "subSampleOnset", json_boolean(saved.subSampleOnset));
+    json_object_set_new(rootJ, "midiEnabled", json_boolean(saved.midiEnabled));
+    json_object_set_new(rootJ, "midiVoices", json_integer(saved.midiVoices));
+    json_object_set_new(rootJ, "wheelToAmount", json_boolean(saved.wheelToAmount));
+    json_object_set_new(rootJ, "aftertouchToAmount", json_boolean(saved.aftertouchToAmount));
+    json_object_set_new(rootJ, "monoBlockMode", json_boolean(saved.monoBlockMode));
+    json_object_set_new(rootJ, "snapToBeat", json_boolean(saved.snapToBeat));
+    json_object_set_new(rootJ, "midi", midiInput.toJson());
+    json_object_set_new(rootJ, "chainEnabled", json_boolean(chain.isEnabled()));
+    json_object_set_new(rootJ, "clockPeriod", json_real(static_cast<double>(clockFollower.period())));
     return rootJ;
   }
 
   void dataFromJson(json_t* rootJ) override {
-    if (json_t* j = json_object_get(rootJ, "unbendEnvelope")) unbendEnvelope = json_boolean_value(j);
-    if (json_t* j = json_object_get(rootJ, "inverseUnbendShape")) inverseUnbendShape = json_boolean_value(j);
+    BendConfig loaded{getConfig()};
+    if (json_t* j = json_object_get(rootJ, "unbendEnvelope")) loaded.unbendEnvelope = json_boolean_value(j);
+    if (json_t* j = json_object_get(rootJ, "inverseUnbendShape")) loaded.inverseUnbendShape = json_boolean_value(j);
     if (json_t* j = json_object_get(rootJ, "unbendDurationPct"))
-      unbendDurationPct = static_cast<float>(json_real_value(j));
-    if (json_t* j = json_object_get(rootJ, "holdMethod")) holdMethod = static_cast<HoldMethod>(json_integer_value(j));
+      loaded.unbendDurationPct = static_cast<float>(json_real_value(j));
+    if (json_t* j = json_object_get(rootJ, "holdMethod"))
+      loaded.holdMethod = static_cast<HoldMethod>(json_integer_value(j));
     if (json_t* j = json_object_get(rootJ, "autoUnholdThreshold"))
-      autoUnholdThreshold = static_cast<float>(json_real_value(j));
+      loaded.autoUnholdThreshold = static_cast<float>(json_real_value(j));
+    if (json_t* j = json_object_get(rootJ, "subSampleOnset")) loaded.subSampleOnset = json_boolean_value(j);
+    if (json_t* j = json_object_get(rootJ, "midiEnabled")) loaded.midiEnabled = json_boolean_value(j);
+    if (json_t* j = json_object_get(rootJ, "midiVoices"))
+      loaded.midiVoices = rack::math::clamp(static_cast<int>(json_integer_value(j)), 1, DANT::CHANS);
+    if (json_t* j = json_object_get(rootJ, "wheelToAmount")) loaded.wheelToAmount = json_boolean_value(j);
+    if (json_t* j = json_object_get(rootJ, "aftertouchToAmount")) loaded.aftertouchToAmount = json_boolean_value(j);
+    if (json_t* j = json_object_get(rootJ, "monoBlockMode")) loaded.monoBlockMode = json_boolean_value(j);
+    if (json_t* j = json_object_get(rootJ, "snapToBeat")) loaded.snapToBeat = json_boolean_value(j);
+    if (json_t* j = json_object_get(rootJ, "midi")) midiInput.fromJson(j);
+    setConfig(loaded);
+    if (json_t* j = json_object_get(rootJ, "chainEnabled")) {
+      chain.setEnabled(json_boolean_value(j));
+    }
+    // the first clocked bends after loading use the saved clock's period
+    if (json_t* j = json_object_get(rootJ, "clockPeriod")) {
+      clockFollower.restore(static_cast<float>(json_real_value(j)));
+      updateClockDurations();
+    }
+  }
+
+  // the engine routes the signals straight through, a state reader still hears from Bend every frame so it doesn't
+  // hold the last state it was sent
+  void processBypass(const rack::engine::Module::ProcessArgs& args) override {
+    if (stateReaderRight) {
+      sendIdleState();
+    }
+    rack::engine::Module::processBypass(args);
   }
 
   void process(const rack::engine::Module::ProcessArgs& args) override {
-    int numChannels = inputs[SIGNALS_INPUT].getChannels();
-    gridLightChannels = numChannels;
+    DANT::ProcessTimer timer{processTiming};  // nothing unless built with DANT_PERF_TIMING
+    // nothing unless capturing, developer mode only, a chained module's signal is captured in place of the input
+    capture.record(*this, SIGNALS_INPUT, &chain.input(*this, inputs[SIGNALS_INPUT]));
+
+    if (configBuffer.update()) {
+      applyConfig(configBuffer.read());
+    }
+    if (eco.update()) {
+      snapshotDivider.setDivision(eco.snapshotDivision());
+    }
+    // every sample, or every ECO_CV_DIVISION samples in Eco mode
+    const bool controlFrame{eco.readCvs()};
+    if (controlFrame && eco.enabled) {
+      readControlRateCvs();
+    }
+
+    processMidi(args.frame);
 
-    processResets();
+    int numChannels = signalsInput().getChannels();
+
+    if (controlFrame) {
+      processResets();
+    }
 
     if (numChannels > 0) {
       processClock(args.sampleTime);
 
-      for (int c{0}; c < numChannels; ++c) {
-        if (processBendTriggers(c)) {
-          triggerBend(c);
+      for (int block{0}; block * DANT::SIMD < numChannels; ++block) {
+        const rack::simd::float_4 trigIn{readBendTriggers(block)};
+        int fired{bendTriggers.process(block, trigIn, DANT::validLanes(numChannels, block))};
+        // seconds each lane's bend starts from, 0 unless sub-sample onsets are on
+        rack::simd::float_4 onsets{rack::simd::float_4::zero()};
+        if (fired != 0 && config.subSampleOnset && !config.midiEnabled) {  // MIDI notes are already frame exact
+          // the bend advances a whole sample on this one, so it starts from the crossing, a fraction of a sample ago
+          onsets = (DANT::onsetDelay(previousBendTriggers[block], trigIn) - 1.0f) * args.sampleTime;
+        }
+        previousBendTriggers[block] = trigIn;
+        for (; fired != 0; fired &= fired - 1) {
+          const int lane{__builtin_ctz(fired)};
+          const int c{(block * DANT::SIMD) + lane};
+          if (processBendTrigger(c)) {
+            triggerBend(c, onsets[lane]);
+          }
         }
       }
 
-      for (int c{0}; c < numChannels; c += DANT::SIMD) {
-        rack::simd::float_4 inputSignals = inputs[SIGNALS_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
-        DANT::BendOpts opts;
-        int block = c / 4;
-        float validLanes[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-        for (int i = 0; i < DANT::SIMD; ++i) {
-          if (c + i < numChannels) validLanes[i] = 1.0f;
-        }
-        rack::simd::float_4 validMask = rack::simd::float_4::load(validLanes) > 0.5f;
-        rack::simd::float_4 activeMask = (bendStates[block].active != 0.0f) & validMask;
-        if (rack::simd::movemask(activeMask) != 0) {
-          rack::simd::float_4 trackCV =
-              inputs[BEND_TRACKING_CV_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
-          rack::simd::float_4 trackKnob = params[BEND_TRACKING_PARAM].getValue();
-          rack::simd::float_4 isSampledMask = (trackCV < 0.0f) | ((trackCV == 0.0f) & (trackKnob < 0.5f));
-          rack::simd::float_4 shouldSampleMask = isSampledMask & activeMask;
-          inputSignals = rack::simd::ifelse(shouldSampleMask, bendStates[block].sampledInputPitch, inputSignals);
-          rack::simd::float_4 shapeCV =
-              inputs[BEND_SHAPE_CV_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
-          rack::simd::float_4 shapeKnob = params[BEND_SHAPE_PARAM].getValue();
-          opts.shape = rack::simd::clamp(shapeKnob + shapeCV, -1.0f, 1.0f);
-          bendStates[block].elapsedSeconds = rack::simd::ifelse(
-              activeMask, bendStates[block].elapsedSeconds + args.sampleTime, bendStates[block].elapsedSeconds);
-          rack::simd::float_4 maskTotalPos = bendStates[block].totalSeconds > 0.0f;
-          rack::simd::float_4 prog =
-              rack::simd::ifelse(maskTotalPos, bendStates[block].elapsedSeconds / bendStates[block].totalSeconds, 1.0f);
-          rack::simd::float_4 compCV =
-              inputs[BEND_COMPLETION_CV_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
-          rack::simd::float_4 paramComp = params[BEND_COMPLETION_PARAM].getValue();
-          rack::simd::float_4 maskIsHold = (compCV > 0.0f) | ((compCV == 0.0f) & (paramComp > 0.5f));
-          rack::simd::float_4 wantsUnholdMask = rack::simd::float_4::zero();
-
-          if (holdMethod == GATE_BENDS) {
-            rack::simd::float_4 trigIn =
-                inputs[BEND_TRIG_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c) +
-                params[BEND_TRIG_PARAM].getValue();
-            wantsUnholdMask = trigIn <= 0.0f;
-          } else {
-            rack::simd::float_4 progFinishedMask = prog >= 1.0f;
-            rack::simd::float_4 isReturnMask = maskIsHold == 0.0f;
-            wantsUnholdMask = wantsUnholdMask | (progFinishedMask & isReturnMask);
-            if (holdMethod == AUTO_UNHOLD) {
-              rack::simd::float_4 currentInput =
-                  inputs[SIGNALS_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
-              rack::simd::float_4 pitchDiffAbs = rack::simd::abs(currentInput - bendStates[block].sampledInputPitch);
-              rack::simd::float_4 diffExceededMask = pitchDiffAbs > autoUnholdThreshold;
-              wantsUnholdMask = wantsUnholdMask | (progFinishedMask & diffExceededMask);
-            }
-          }
-          rack::simd::float_4 isNotUnbendingMask = bendStates[block].isUnbending == 0.0f;
-          rack::simd::float_4 triggerUnholdMask = activeMask & wantsUnholdMask & isNotUnbendingMask;
-          if (rack::simd::movemask(triggerUnholdMask) != 0) {
-            rack::simd::float_4 clampedProg = rack::simd::fmax(0.0f, prog);
-            rack::simd::float_4 exp = rack::dsp::exp2_taylor5(opts.shape * 2.0f);
-            rack::simd::float_4 curved =
-                rack::simd::ifelse(clampedProg > 0.0f, rack::simd::pow(clampedProg, exp), 0.0f);
-            rack::simd::float_4 currentOffset =
-                bendStates[block].startOffset +
-                (bendStates[block].targetOffset - bendStates[block].startOffset) * curved;
-            currentOffset = rack::simd::ifelse(prog >= 1.0f, bendStates[block].targetOffset, currentOffset);
-            if (unbendEnvelope) {
-              bendStates[block].isUnbending =
-                  rack::simd::ifelse(triggerUnholdMask, 1.0f, bendStates[block].isUnbending);
-              bendStates[block].startOffset =
-                  rack::simd::ifelse(triggerUnholdMask, currentOffset, bendStates[block].startOffset);
-              bendStates[block].targetOffset =
-                  rack::simd::ifelse(triggerUnholdMask, 0.0f, bendStates[block].targetOffset);
-              bendStates[block].elapsedSeconds =
-                  rack::simd::ifelse(triggerUnholdMask, 0.0f, bendStates[block].elapsedSeconds);
-              bendStates[block].totalSeconds = rack::simd::ifelse(
-                  triggerUnholdMask, rack::simd::fmax(0.0f, bendStates[block].totalSeconds * unbendDurationPct),
-                  bendStates[block].totalSeconds);
-              prog = rack::simd::ifelse(triggerUnholdMask, 0.0f, prog);
-            } else {
-              bendStates[block].active = rack::simd::ifelse(triggerUnholdMask, 0.0f, bendStates[block].active);
-              prog = rack::simd::ifelse(triggerUnholdMask, 0.0f, prog);
-              bendStates[block].startOffset =
-                  rack::simd::ifelse(triggerUnholdMask, 0.0f, bendStates[block].startOffset);
-              bendStates[block].targetOffset =
-                  rack::simd::ifelse(triggerUnholdMask, 0.0f, bendStates[block].targetOffset);
-              rack::simd::float_4 rawInputs =
-                  inputs[SIGNALS_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
-              inputSignals = rack::simd::ifelse(triggerUnholdMask, rawInputs, inputSignals);
-            }
-          }
-          rack::simd::float_4 isUnbendingMask = bendStates[block].isUnbending != 0.0f;
-          rack::simd::float_4 triggerFinishUnbendMask = activeMask & (prog >= 1.0f) & isUnbendingMask;
-          if (rack::simd::movemask(triggerFinishUnbendMask) != 0) {
-            bendStates[block].active = rack::simd::ifelse(triggerFinishUnbendMask, 0.0f, bendStates[block].active);
-            bendStates[block].isUnbending =
-                rack::simd::ifelse(triggerFinishUnbendMask, 0.0f, bendStates[block].isUnbending);
-            prog = rack::simd::ifelse(triggerFinishUnbendMask, 0.0f, prog);
-            bendStates[block].startOffset =
-                rack::simd::ifelse(triggerFinishUnbendMask, 0.0f, bendStates[block].startOffset);
-            bendStates[block].targetOffset =
-                rack::simd::ifelse(triggerFinishUnbendMask, 0.0f, bendStates[block].targetOffset);
-            rack::simd::float_4 rawInputs =
-                inputs[SIGNALS_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
-            inputSignals = rack::simd::ifelse(triggerFinishUnbendMask, rawInputs, inputSignals);
-          }
-          prog = rack::simd::ifelse(prog > 1.0f, 1.0f, prog);
-          opts.startOffsets = bendStates[block].startOffset;
-          opts.targetOffsets = bendStates[block].targetOffset;
-          opts.progress = prog;
-          opts.isUnbending = bendStates[block].isUnbending;
-          opts.inverseUnbend = inverseUnbendShape;
-          activeMask = (bendStates[block].active != 0.0f) & validMask;
-          rack::simd::float_4 intensity = rack::simd::fmin(1.0f, prog);
-          rack::simd::float_4 isCurrentlyUnbending = bendStates[block].isUnbending != 0.0f;
-          intensity = rack::simd::ifelse(isCurrentlyUnbending, 1.0f - intensity, intensity);
-          intensity = rack::simd::ifelse(prog >= 1.0f, 1.0f, intensity);
-          rack::simd::float_4 finalIntensity = rack::simd::ifelse(activeMask, intensity * bendStates[block].isUp, 0.0f);
-          gridLightValues[block] = finalIntensity;
-        } else {
-          gridLightValues[block] = rack::simd::float_4::zero();
+      const bool blockMode{numChannels == 1 && config.monoBlockMode};
+      if (blockMode != monoBlock.isEnabled()) {
+        monoBlock.setEnabled(blockMode);
+      }
+
+      rack::engine::Input& signals{signalsInput()};
+      if (monoBlock.isEnabled()) {
+        meterFrame = true;  // mono block mode already meters once per 4 frames
+        const float bentVal{monoBlock.process(signals.getVoltage(), [&](const rack::simd::float_4 rawFrames) {
+          ++meteredFrames;
+          return processFrames(rawFrames, args.sampleTime);
+        })};
+        outputs[SIGNALS_OUTPUT].setVoltage(bentVal);
+        outputs[SIGNALS_OUTPUT].setChannels(1);
+      } else {
+        meterFrame = controlFrame;
+        meteredFrames += meterFrame ? 1 : 0;
+        // hand rolled rather than DANT::PolyProcessor, which benchmarked slower for Bend's larger block kernel
+        for (int c{0}; c < numChannels; c += DANT::SIMD) {
+          const int block{c / DANT::SIMD};
+          const rack::simd::float_4 validMask{DANT::LANE_MASKS.masks[DANT::validLanes(numChannels, block)]};
+          const rack::simd::float_4 rawInputs{signals.getVoltageSimd<rack::simd::float_4>(c)};
+          outputs[SIGNALS_OUTPUT].setVoltageSimd(processBlock(block, c, rawInputs, validMask, args.sampleTime), c);
         }
-        rack::simd::float_4 outSignals = DANT::bendVoct(inputSignals, opts);
-        outputs[SIGNALS_OUTPUT].setVoltageSimd<rack::simd::float_4>(outSignals, c);
+        outputs[SIGNALS_OUTPUT].setChannels(numChannels);
       }
+    }
 
-      outputs[SIGNALS_OUTPUT].setChannels(numChannels);
+    processBendTrigPeaks();
+    if (lightDivider.process()) {
+      updateLights(args.sampleTime * static_cast<float>(lightDivider.getDivision()));
     }
 
-    bool resetActive = params[RESET_PARAM].getValue() > 0.0f;
-    for (int c = 0; c < std::max(1, inputs[RESET_INPUT].getChannels()); ++c) {
-      if (inputs[RESET_INPUT].getPolyVoltage(c) > 0.0f) {
-        resetActive = true;
-        break;
+    if (snapshotDivider.process()) {
+      intensityMeter.reduce(meteredFrames);
+      meteredFrames = 0;
+      DANT::GridLightState gridLights;
+      gridLights.numChannels = numChannels;
+      std::copy(intensityMeter.peak, intensityMeter.peak + DANT::SIMD, gridLights.peak);
+      std::copy(intensityMeter.rms, intensityMeter.rms + DANT::SIMD, gridLights.rms);
+      gridSnapshot.publish(gridLights);
+      publishCvSnapshot();
+    }
+    chain.send(*this, outputs[SIGNALS_OUTPUT]);
+    if (stateReaderRight) {
+      sendBendState(numChannels);
+    }
+  }
+
+  // takes new settings and derives the values the per sample code uses
+  void applyConfig(const BendConfig& newConfig) {
+    config = newConfig;
+    unbendDurationScale = std::fmax(0.0f, config.unbendDurationPct);
+    autoUnholdVolts = config.autoUnholdThreshold;
+    midi.setVoices(config.midiVoices);
+    updateMidiPorts();
+  }
+
+  // the pitches bent and the bend triggers, Bend's own ports, a chained module's signal or its MIDI input's voices
+  inline rack::engine::Input& signalsInput() {
+    return config.midiEnabled ? midiPitch : chain.input(*this, inputs[SIGNALS_INPUT]);
+  }
+  inline rack::engine::Input& triggerInput() { return config.midiEnabled ? midiGates : inputs[BEND_TRIG_INPUT]; }
+
+  // takes the MIDI messages due by this frame, so each note starts on the frame it was timestamped for,
+  // the queue is drained while MIDI is disabled too, so enabling it doesn't replay stale notes
+  inline void processMidi(const int64_t frame) {
+    bool changed{false};
+    while (midiInput.tryPop(&midiMessage, frame)) {
+      const int voice{midi.process(midiMessage)};
+      if (voice >= 0 && config.midiEnabled) {
+        bendTriggers.rearm(voice);  // a retriggered or stolen voice fires although its gate is already high
       }
+      changed = true;
+    }
+    if (changed) {
+      updateMidiPorts();
+    }
+  }
+
+  inline void updateMidiPorts() {
+    const int voices{midi.getVoices()};
+    for (int c{0}; c < voices; ++c) {
+      midiPitch.voltages[c] = midi.pitch(c);
+      midiGates.voltages[c] = midi.gates.test(c) ? 10.0f : 0.0f;
+    }
+    midiPitch.channels = static_cast<uint8_t>(voices);
+    midiGates.channels = static_cast<uint8_t>(voices);
+  }
+
+  // V/Oct added to the bend amount CV from the pitch wheel and aftertouch, when mapped
+  inline float readMidiAmount(const int channel) {
+    return (config.wheelToAmount ? midi.wheel : 0.0f) + (config.aftertouchToAmount ? midi.pressure[channel] : 0.0f);
+  }
+
+  // keeps the highest bend trigger voltages, so a trigger shorter than the light interval still lights the button
+  inline void processBendTrigPeaks() {
+    rack::engine::Input& triggers{triggerInput()};
+    const int trigChannels{std::max(1, triggers.getChannels())};
+    for (int block{0}; block * DANT::SIMD < trigChannels; ++block) {
+      const rack::simd::float_4 trigIn{triggers.getVoltageSimd<rack::simd::float_4>(block * DANT::SIMD)};
+      const rack::simd::float_4 validMask{DANT::LANE_MASKS.masks[DANT::validLanes(trigChannels, block)]};
+      bendTrigPeak = rack::simd::fmax(bendTrigPeak, trigIn & validMask);
+    }
+  }
+
+  // a light is on when its button is pressed or any channel of its input went high since the last update
+  inline void updateLights(const float deltaTime) {
+    const bool resetActive{params[RESET_PARAM].getValue() > 0.0f || rack::simd::movemask(resetPeak > 0.0f) != 0};
+    const bool bendTrigActive{params[BEND_TRIG_PARAM].getValue() > 0.0f ||
+                              rack::simd::movemask(bendTrigPeak > 0.0f) != 0};
+    setLight(RESET_LIGHT, resetActive, deltaTime);
+    setLight(BEND_TRIG_LIGHT, bendTrigActive, deltaTime);
+    resetPeak = rack::simd::float_4::zero();
+    bendTrigPeak = rack::simd::float_4::zero();
+  }
+
+  // smoothed, or set directly in Eco mode
+  inline void setLight(const int light, const bool on, const float deltaTime) {
+    if (eco.enabled) {
+      lights[light].setBrightness(on ? 1.0f : 0.0f);
+    } else {
+      lights[light].setSmoothBrightness(on ? 1.0f : 0.0f, deltaTime);
+    }
+  }
+
+  // Eco mode, reads the CVs advanceBend uses for every block, once every ECO_CV_DIVISION samples
+  inline void readControlRateCvs() {
+    for (int block{0}; block < DANT::SIMD; ++block) {
+      const int c{block * DANT::SIMD};
+      controlCvs.tracking[block] =
+          inputs[BEND_TRACKING_CV_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
+      controlCvs.shape[block] = inputs[BEND_SHAPE_CV_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
+      controlCvs.completion[block] =
+          inputs[BEND_COMPLETION_CV_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
     }
-    lights[RESET_LIGHT].setSmoothBrightness(resetActive ? 1.0f : 0.0f, args.sampleTime);
+  }
+
+  // a block's CV, read every sample or taken from the control rate copy in Eco mode
+  inline rack::simd::float_4 readBlockCv(const int input, const rack::simd::float_4* controlRate, const int block,
+                                         const int c) {
+    return eco.enabled ? controlRate[block] : inputs[input].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c);
+  }
 
-    bool bendTrigActive = params[BEND_TRIG_PARAM].getValue() > 0.0f;
-    for (int c = 0; c < std::max(1, inputs[BEND_TRIG_INPUT].getChannels()); ++c) {
-      if (inputs[BEND_TRIG_INPUT].getPolyVoltage(c) > 0.0f) {
-        bendTrigActive = true;
-        break;
+  // copies the first channel of every input for the knob CV visualisations
+  inline void publishCvSnapshot() {
+    static_assert(NUM_INPUTS <= DANT::CHANS, "CvState holds one voltage per input");
+    DANT::CvState cvState;
+    for (int i{0}; i < NUM_INPUTS; ++i) {
+      cvState.voltages[i] = inputs[i].getNormalVoltage(0.0f);
+    }
+    cvSnapshot.publish(cvState);
+  }
+
+  // runs the bend state machine and bend for one block of channels, rawInputs are the unbent input signals
+  inline rack::simd::float_4 processBlock(const int block, const int c, const rack::simd::float_4 rawInputs,
+                                          const rack::simd::float_4 validMask, const float sampleTime) {
+    DANT::BendOpts opts;
+    const rack::simd::float_4 useSampledMask{advanceBend(block, c, rawInputs, validMask, sampleTime, opts)};
+    return DANT::bendVoct(rack::simd::ifelse(useSampledMask, lanes.sampledInputPitch[block], rawInputs), opts);
+  }
+
+  /**
+   * Mono block mode kernel, rawFrames holds 4 consecutive samples of channel 0.
+   * The state machine advances once per 4 frames, the bend progress is interpolated across the frames.
+   */
+  inline rack::simd::float_4 processFrames(const rack::simd::float_4 rawFrames, const float sampleTime) {
+    static const rack::simd::float_4 FRAME_OFFSETS{-3.0f, -2.0f, -1.0f, 0.0f};  // frames before the last frame
+    DANT::BendOpts opts;
+    const rack::simd::float_4 useSampledMask{advanceBend(0, 0, rack::simd::float_4(rawFrames[3]),
+                                                         DANT::LANE_MASKS.masks[0x1],
+                                                         sampleTime * DANT::SIMD, opts)};
+
+    // lane 0 holds the channel state, spread it across the frames
+    const float totalSeconds{lanes.totalSeconds[0][0]};
+    const float progressStep{totalSeconds > 0.0f ? sampleTime / totalSeconds : 0.0f};
+    DANT::BendOpts frameOpts;
+    frameOpts.startOffsets = opts.startOffsets[0];
+    frameOpts.targetOffsets = opts.targetOffsets[0];
+    frameOpts.shape = opts.shape[0];
+    frameOpts.isUnbending = opts.isUnbending[0];
+    frameOpts.inverseUnbend = opts.inverseUnbend;
+    frameOpts.math = opts.math;
+    // a bend that finished within the frames is still short of its target on the frames before
+    const float lastProgress{opts.progress[0] >= 1.0f && totalSeconds > 0.0f
+                                 ? lanes.elapsedSeconds[0][0] / totalSeconds
+                                 : opts.progress[0]};
+    frameOpts.progress = rack::simd::fmin(1.0f, lastProgress + (FRAME_OFFSETS * progressStep));
+
+    const bool useSampled{(rack::simd::movemask(useSampledMask) & 1) != 0};
+    return DANT::bendVoct(useSampled ? rack::simd::float_4(lanes.sampledInputPitch[0][0]) : rawFrames, frameOpts);
+  }
+
+  /**
+   * Advances the bend state machine for one block of channels by sampleTime and fills opts for bendVoct.
+   * Returns the mask of lanes that bend the sampled input pitch instead of the raw input.
+   */
+  inline rack::simd::float_4 advanceBend(const int block, const int c, const rack::simd::float_4 rawInputs,
+                                         const rack::simd::float_4 validMask, const float sampleTime,
+                                         DANT::BendOpts& opts) {
+    rack::simd::float_4 useSampledMask{rack::simd::float_4::zero()};
+    rack::simd::float_4 activeMask = activeLanes.mask(block) & validMask;
+    if (rack::simd::movemask(activeMask) != 0) {
+      rack::simd::float_4 trackCV = readBlockCv(BEND_TRACKING_CV_INPUT, controlCvs.tracking, block, c);
+      rack::simd::float_4 trackKnob = params[BEND_TRACKING_PARAM].getValue();
+      rack::simd::float_4 isSampledMask = (trackCV < 0.0f) | ((trackCV == 0.0f) & (trackKnob < 0.5f));
+      rack::simd::float_4 shouldSampleMask = isSampledMask & activeMask;
+      useSampledMask = shouldSampleMask;
+      rack::simd::float_4 shapeCV = readBlockCv(BEND_SHAPE_CV_INPUT, controlCvs.shape, block, c);
+      rack::simd::float_4 shapeKnob = params[BEND_SHAPE_PARAM].getValue();
+      opts.shape = rack::simd::clamp(shapeKnob + shapeCV, -1.0f, 1.0f);
+      opts.math = eco.enabled ? DANT::ECO_MATH : DANT::PRECISE_MATH;
+      lanes.elapsedSeconds[block] = rack::simd::ifelse(
+          activeMask, lanes.elapsedSeconds[block] + sampleTime, lanes.elapsedSeconds[block]);
+      rack::simd::float_4 maskTotalPos = lanes.totalSeconds[block] > 0.0f;
+      rack::simd::float_4 prog =
+          rack::simd::ifelse(maskTotalPos, lanes.elapsedSeconds[block] / lanes.totalSeconds[block], 1.0f);
+      rack::simd::float_4 compCV = readBlockCv(BEND_COMPLETION_CV_INPUT, controlCvs.completion, block, c);
+      rack::simd::float_4 paramComp = params[BEND_COMPLETION_PARAM].getValue();
+      rack::simd::float_4 maskIsHold = (compCV > 0.0f) | ((compCV == 0.0f) & (paramComp > 0.5f));
+      rack::simd::float_4 wantsUnholdMask = rack::simd::float_4::zero();
+
+      if (config.holdMethod == GATE_BENDS) {
+        rack::simd::float_4 trigIn =
+            triggerInput().getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, c) +
+            params[BEND_TRIG_PARAM].getValue();
+        wantsUnholdMask = trigIn <= 0.0f;
+      } else {
+        rack::simd::float_4 progFinishedMask = prog >= 1.0f;
+        rack::simd::float_4 isReturnMask = maskIsHold == 0.0f;
+        wantsUnholdMask = wantsUnholdMask | (progFinishedMask & isReturnMask);
+        if (config.holdMethod == AUTO_UNHOLD) {
+          rack::simd::float_4 pitchDiffAbs = rack::simd::abs(rawInputs - lanes.sampledInputPitch[block]);
+          rack::simd::float_4 diffExceededMask = pitchDiffAbs > autoUnholdVolts;
+          wantsUnholdMask = wantsUnholdMask | (progFinishedMask & diffExceededMask);
+        }
       }
+      rack::simd::float_4 triggerUnholdMask = activeMask & wantsUnholdMask & unbendingLanes.unsetMask(block);
+      if (rack::simd::movemask(triggerUnholdMask) != 0) {
+        rack::simd::float_4 clampedProg = rack::simd::fmax(0.0f, prog);
+        rack::simd::float_4 exp = rack::dsp::exp2_taylor5(opts.shape * 2.0f);
+        rack::simd::float_4 curved = DANT::bendCurve(clampedProg, exp, opts.math);
+        rack::simd::float_4 currentOffset =
+            lanes.startOffset[block] +
+            (lanes.targetOffset[block] - lanes.startOffset[block]) * curved;
+        currentOffset = rack::simd::ifelse(prog >= 1.0f, lanes.targetOffset[block], currentOffset);
+        if (config.unbendEnvelope) {
+          unbendingLanes.set(block, triggerUnholdMask, true);
+          lanes.unbendFrom[block] = rack::simd::ifelse(
+              triggerUnholdMask, rack::simd::ifelse(prog >= 1.0f, 1.0f, curved), lanes.unbendFrom[block]);
+          lanes.startOffset[block] =
+              rack::simd::ifelse(triggerUnholdMask, currentOffset, lanes.startOffset[block]);
+          lanes.targetOffset[block] = rack::simd::ifelse(triggerUnholdMask, 0.0f, lanes.targetOffset[block]);
+          lanes.elapsedSeconds[block] =
+              rack::simd::ifelse(triggerUnholdMask, 0.0f, lanes.elapsedSeconds[block]);
+          lanes.totalSeconds[block] = rack::simd::ifelse(
+              triggerUnholdMask, lanes.totalSeconds[block] * unbendDurationScale,
+              lanes.totalSeconds[block]);
+          prog = rack::simd::ifelse(triggerUnholdMask, 0.0f, prog);
+        } else {
+          activeLanes.set(block, triggerUnholdMask, false);
+          prog = rack::simd::ifelse(triggerUnholdMask, 0.0f, prog);
+          lanes.startOffset[block] = rack::simd::ifelse(triggerUnholdMask, 0.0f, lanes.startOffset[block]);
+          lanes.targetOffset[block] = rack::simd::ifelse(triggerUnholdMask, 0.0f, lanes.targetOffset[block]);
+          useSampledMask = rack::simd::ifelse(triggerUnholdMask, 0.0f, useSampledMask);
+        }
+      }
+      rack::simd::float_4 triggerFinishUnbendMask = activeMask & (prog >= 1.0f) & unbendingLanes.mask(block);
+      if (rack::simd::movemask(triggerFinishUnbendMask) != 0) {
+        activeLanes.set(block, triggerFinishUnbendMask, false);
+        unbendingLanes.set(block, triggerFinishUnbendMask, false);
+        prog = rack::simd::ifelse(triggerFinishUnbendMask, 0.0f, prog);
+        lanes.startOffset[block] =
+            rack::simd::ifelse(triggerFinishUnbendMask, 0.0f, lanes.startOffset[block]);
+        lanes.targetOffset[block] =
+            rack::simd::ifelse(triggerFinishUnbendMask, 0.0f, lanes.targetOffset[block]);
+        useSampledMask = rack::simd::ifelse(triggerFinishUnbendMask, 0.0f, useSampledMask);
+      }
+      prog = rack::simd::ifelse(prog > 1.0f, 1.0f, prog);
+      opts.startOffsets = lanes.startOffset[block];
+      opts.targetOffsets = lanes.targetOffset[block];
+      opts.progress = prog;
+      const rack::simd::float_4 isUnbendingMask{unbendingLanes.mask(block)};
+      opts.isUnbending = rack::simd::ifelse(isUnbendingMask, 1.0f, 0.0f);
+      opts.inverseUnbend = config.inverseUnbendShape;
+      activeMask = activeLanes.mask(block) & validMask;
+      rack::simd::float_4 intensity = rack::simd::fmin(1.0f, prog);
+      intensity = rack::simd::ifelse(isUnbendingMask, 1.0f - intensity, intensity);
+      intensity = rack::simd::ifelse(prog >= 1.0f, 1.0f, intensity);
+      const rack::simd::float_4 signedIntensity{rack::simd::ifelse(upLanes.mask(block), intensity, -intensity)};
+      if (meterFrame) {
+        intensityMeter.process(rack::simd::ifelse(activeMask, signedIntensity, 0.0f), block);
+      }
+    }
+    if (stateReaderRight) {
+      writeBlockState(block, opts, activeLanes.mask(block) & validMask);
+    }
+    return useSampledMask;
+  }
+
+  // the block's progress and envelope for the module on the right, 0 for idle lanes
+  inline void writeBlockState(const int block, const DANT::BendOpts& opts, const rack::simd::float_4 activeMask) {
+    if (rack::simd::movemask(activeMask) == 0) {
+      bendState.progress[block] = rack::simd::float_4::zero();
+      bendState.envelope[block] = rack::simd::float_4::zero();
+      return;
     }
-    lights[BEND_TRIG_LIGHT].setSmoothBrightness(bendTrigActive ? 1.0f : 0.0f, args.sampleTime);
+    bendState.progress[block] = opts.progress & activeMask;
+    bendState.envelope[block] = DANT::bendEnvelope(opts, lanes.unbendFrom[block]) & activeMask;
+  }
+
+  // completes the state with the lanes' phases and sends all of it, every sample, the engine flips between two
+  // messages, so a state only written on the samples mono block mode advances would leave the other message stale
+  inline void sendBendState(const int numChannels) {
+    const uint16_t valid{static_cast<uint16_t>((1u << numChannels) - 1u)};
+    const uint16_t active{static_cast<uint16_t>(activeLanes.bits & valid)};
+    uint16_t finished{0u};
+    for (int block{0}; block * DANT::SIMD < numChannels; ++block) {
+      finished = static_cast<uint16_t>(
+          finished | (rack::simd::movemask(bendState.progress[block] >= 1.0f) << (block * DANT::SIMD)));
+    }
+    bendState.unbending.bits = static_cast<uint16_t>(active & unbendingLanes.bits);
+    bendState.holding.bits = static_cast<uint16_t>(active & ~unbendingLanes.bits & finished);
+    bendState.bending.bits = static_cast<uint16_t>(active & ~unbendingLanes.bits & ~finished);
+    bendState.ended.bits = static_cast<uint16_t>(stateActive.bits & ~active);
+    bendState.channels = numChannels;
+    stateActive.bits = active;
+    writeBendState(bendState);
+  }
+
+  // bypassed, every bend sent as active ends, so the reader's gates fall and its end triggers fire once
+  inline void sendIdleState() {
+    DANT::BendPolyState idle;
+    idle.channels = bendState.channels;
+    idle.ended.bits = stateActive.bits;
+    stateActive.clear();
+    writeBendState(idle);
+  }
+
+  inline void writeBendState(const DANT::BendPolyState& state) {
+    rack::engine::Module::Expander& expander = rightExpander.module->leftExpander;
+    *static_cast<DANT::BendPolyState*>(expander.producerMessage) = state;
+    expander.requestMessageFlip();
   }
 
   inline void processResets() {
     bool manualReset = params[RESET_PARAM].getValue() > 0.0f;
     bool globalResetTrig = false;
     int resetChannels = inputs[RESET_INPUT].getChannels();
-    for (int c = 0; c < DANT::CHANS; ++c) {
-      float resetIn = inputs[RESET_INPUT].getNormalPolyVoltage(0.0f, c);
-      if (resetTriggerDetectors[c].process(resetIn)) {
-        if (resetChannels <= 1 && c == 0) {
-          globalResetTrig = true;
-        } else if (resetChannels > 1) {
-          softReset(c);
-        }
+    const int lightChannels{std::max(1, resetChannels)};
+    for (int block{0}; block < DANT::SIMD; ++block) {
+      const rack::simd::float_4 resetIn{
+          inputs[RESET_INPUT].getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, block * DANT::SIMD)};
+      resetPeak = rack::simd::fmax(resetPeak, resetIn & DANT::LANE_MASKS.masks[DANT::validLanes(lightChannels, block)]);
+      int fired{resetTriggers.process(block, resetIn)};
+      if (resetChannels <= 1) {
+        globalResetTrig = globalResetTrig || (block == 0 && (fired & 1) != 0);
+        continue;
+      }
+      for (; fired != 0; fired &= fired - 1) {
+        softReset((block * DANT::SIMD) + __builtin_ctz(fired));
       }
     }
     if (manualReset || globalResetTrig) {
@@ -400,16 +778,23 @@ struct BendModule : rack::engine::Module {
   }
 
   inline void processClock(float sampleTime) {
-    clockTimer += sampleTime;
-    if (inputs[EXT_CLOCK_INPUT].isConnected()) {
-      clockedMode = true;
-      if (clockTrigger.process(inputs[EXT_CLOCK_INPUT].getVoltage())) {
-        clockPeriod = clockTimer;
-        clockTimer = 0.0f;
+    if (!inputs[EXT_CLOCK_INPUT].isConnected()) {
+      if (clockedMode) {
+        clockFollower.restart();  // keeps the period for when a clock is reconnected
       }
-    } else {
       clockedMode = false;
-      clockPeriod = 0.0f;
+      return;
+    }
+    clockedMode = true;
+    if (clockFollower.process(inputs[EXT_CLOCK_INPUT].getVoltage(), sampleTime)) {
+      updateClockDurations();
+    }
+  }
+
+  // once per period change, so triggers only look up their division's duration
+  inline void updateClockDurations() {
+    for (int i{0}; i < NUM_DIVISIONS; ++i) {
+      clockDurations[i] = clockFollower.period() * divisions[i].multiplier;
     }
   }
 
@@ -421,48 +806,43 @@ struct BendModule : rack::engine::Module {
                                                             : DANT::BEND_DIR::TOWARDS_PITCH;
   }
 
-  inline bool processBendTriggers(int channel) {
+  // called for a channel whose trigger fired, false when the trigger released a held bend instead of starting one
+  inline bool processBendTrigger(int channel) {
+    if (config.holdMethod != TOGGLE_TRIGGERS || !readBendCompletion(channel) || !activeLanes.test(channel) ||
+        unbendingLanes.test(channel)) {
+      return true;
+    }
     int block = channel / 4;
     int lane = channel % 4;
-    float trigIn = readBendTrigger(channel);
-    bool triggerFired = false;
-    if (holdMethod == GATE_BENDS) {
-      triggerFired = bendTriggerDetectors[channel].process(trigIn);
+    float prog = 1.0f;
+    if (lanes.totalSeconds[block][lane] > 0.0f) {
+      prog = lanes.elapsedSeconds[block][lane] / lanes.totalSeconds[block][lane];
+    }
+    float currentOffset = lanes.targetOffset[block][lane];
+    float curved = 1.0f;
+    if (prog < 1.0f) {
+      float shape = rack::math::clamp(readBendShape(channel), -1.0f, 1.0f);
+      float exp = rack::dsp::exp2_taylor5(shape * 2.0f);
+      curved = prog > 0.0f ? std::pow(prog, exp) : 0.0f;
+      currentOffset = lanes.startOffset[block][lane] +
+                      (lanes.targetOffset[block][lane] - lanes.startOffset[block][lane]) * curved;
+    }
+    if (config.unbendEnvelope) {
+      unbendingLanes.set(channel, true);
+      lanes.unbendFrom[block][lane] = curved;  // the envelope returns from where the bend was released
+      lanes.startOffset[block][lane] = currentOffset;
+      lanes.targetOffset[block][lane] = 0.0f;
+      lanes.elapsedSeconds[block][lane] = 0.0f;
+      lanes.totalSeconds[block][lane] *= unbendDurationScale[0];
     } else {
-      triggerFired = bendTriggerDetectors[channel].process(trigIn);
-      if (triggerFired && holdMethod == TOGGLE_TRIGGERS && readBendCompletion(channel)) {
-        if (bendStates[block].active[lane] != 0.0f && bendStates[block].isUnbending[lane] == 0.0f) {
-          float prog = 1.0f;
-          if (bendStates[block].totalSeconds[lane] > 0.0f) {
-            prog = bendStates[block].elapsedSeconds[lane] / bendStates[block].totalSeconds[lane];
-          }
-          float currentOffset = bendStates[block].targetOffset[lane];
-          if (prog < 1.0f) {
-            float shape = rack::math::clamp(readBendShape(channel), -1.0f, 1.0f);
-            float exp = rack::dsp::exp2_taylor5(shape * 2.0f);
-            float curved = prog > 0.0f ? std::pow(prog, exp) : 0.0f;
-            currentOffset = bendStates[block].startOffset[lane] +
-                            (bendStates[block].targetOffset[lane] - bendStates[block].startOffset[lane]) * curved;
-          }
-          if (unbendEnvelope) {
-            bendStates[block].isUnbending[lane] = 1.0f;
-            bendStates[block].startOffset[lane] = currentOffset;
-            bendStates[block].targetOffset[lane] = 0.0f;
-            bendStates[block].elapsedSeconds[lane] = 0.0f;
-            bendStates[block].totalSeconds[lane] =
-                std::fmax(0.0f, bendStates[block].totalSeconds[lane] * unbendDurationPct);
-          } else {
-            bendStates[block].active[lane] = 0.0f;
-          }
-          triggerFired = false;
-        }
-      }
+      activeLanes.set(channel, false);
     }
-    return triggerFired;
+    return false;
   }
 
-  inline float readBendTrigger(int channel) {
-    return inputs[BEND_TRIG_INPUT].getNormalPolyVoltage(0.0f, channel) + params[BEND_TRIG_PARAM].getValue();
+  inline rack::simd::float_4 readBendTriggers(int block) {
+    return triggerInput().getNormalPolyVoltageSimd<rack::simd::float_4>(0.0f, block * DANT::SIMD) +
+           params[BEND_TRIG_PARAM].getValue();
   }
 
   inline bool readBendCompletion(int channel) {
@@ -472,54 +852,76 @@ struct BendModule : rack::engine::Module {
     return params[BEND_COMPLETION_PARAM].getValue() > 0.5f;
   }
 
-  inline void triggerBend(int channel) {
+  // starts a bend, elapsedSeconds is how long ago the trigger arrived, within the last sample
+  inline void triggerBend(int channel, const float elapsedSeconds = 0.0f) {
     int block = channel / 4;
     int lane = channel % 4;
     float amountVolts = readBendAmount(channel) / 12.0f;
     float duration = 0.01f;
-    if (clockedMode && clockPeriod > 0.0f) {
-      duration = readBendDurationClocked(channel, clockPeriod);
+    if (clockedMode && clockFollower.period() > 0.0f) {
+      duration = readBendDurationClocked(channel);
+      if (config.snapToBeat) {
+        duration = snapToBeat(duration, elapsedSeconds);
+      }
     } else {
       duration = readBendDurationTimed(channel);
     }
     bool isUp = readBendDirection(channel);
-    bendStates[block].active[lane] = 1.0f;
-    bendStates[block].isUnbending[lane] = 0.0f;
-    bendStates[block].elapsedSeconds[lane] = 0.0f;
-    bendStates[block].totalSeconds[lane] = duration;
-    bendStates[block].isUp[lane] = isUp ? 1.0f : -1.0f;
+    activeLanes.set(channel, true);
+    unbendingLanes.set(channel, false);
+    lanes.elapsedSeconds[block][lane] = elapsedSeconds;
+    lanes.totalSeconds[block][lane] = duration;
+    upLanes.set(channel, isUp);
     DANT::BEND_DIR bendDir = readBendOrientation(channel);
     if (bendDir == DANT::BEND_DIR::AWAY_FROM_PITCH) {
-      bendStates[block].startOffset[lane] = 0.0f;
-      bendStates[block].targetOffset[lane] = isUp ? amountVolts : -amountVolts;
+      lanes.startOffset[block][lane] = 0.0f;
+      lanes.targetOffset[block][lane] = isUp ? amountVolts : -amountVolts;
     } else {
-      bendStates[block].startOffset[lane] = isUp ? -amountVolts : amountVolts;
-      bendStates[block].targetOffset[lane] = 0.0f;
+      lanes.startOffset[block][lane] = isUp ? -amountVolts : amountVolts;
+      lanes.targetOffset[block][lane] = 0.0f;
     }
     // We must always record the sampled pitch when triggering a bend,
     // because AUTO_UNHOLD uses this as its baseline reference regardless
     // of whether Continuous Tracking is enabled for the bend mechanics.
-    bendStates[block].sampledInputPitch[lane] = inputs[SIGNALS_INPUT].getNormalPolyVoltage(0.0f, channel);
+    lanes.sampledInputPitch[block][lane] = signalsInput().getNormalPolyVoltage(0.0f, channel);
   }
 
   inline float readBendAmount(int channel) {
     float amountCV = inputs[BEND_AMOUNT_CV_INPUT].getNormalPolyVoltage(0.0f, channel);
+    if (config.midiEnabled) {
+      amountCV += readMidiAmount(channel);
+    }
     float amountSemitones = params[BEND_AMOUNT_PARAM].getValue() + (amountCV * 12.0f);
     return std::fmax(0.0f, amountSemitones);
   }
 
-  inline float readBendDurationClocked(int channel, float clockPeriod) {
+  inline float readBendDurationClocked(int channel) {
     float beatDivCv = inputs[BEAT_DIV_CV_INPUT].getNormalPolyVoltage(0.0f, channel);
     float valF = params[BEAT_DIV_PARAM].getValue() + beatDivCv;
     int val = static_cast<int>(valF + (valF > 0.0f ? 0.5f : -0.5f));
-    float multiplier = 1.0f;
-    if (val >= 0) {
-      multiplier = val + 1.0f;
-    } else {
-      int index = std::max(0, val + 7);
-      multiplier = divisions[index].multiplier;
+    const int index{std::max(0, val + QUARTER_DIVISION)};
+    if (index >= NUM_DIVISIONS) {
+      return clockFollower.period() * (val + 1.0f);  // beyond the table, CV above the 2/1 division
+    }
+    return clockDurations[index];
+  }
+
+  // moves a clocked bend's end onto the grid of beats, or of divisions for bends shorter than a beat, predicted by the
+  // clock follower, so a trigger slightly early or late still ends on the beat, further off it isn't snapped
+  inline float snapToBeat(const float duration, const float elapsedSeconds) const {
+    const float grid{std::fmin(clockFollower.period(), duration)};
+    if (grid <= 0.0f) {
+      return duration;
+    }
+    const float sinceBeat{clockFollower.period() - clockFollower.nextEdge() - elapsedSeconds};
+    float offset{std::fmod(sinceBeat, grid)};
+    if (offset < 0.0f) {
+      offset += grid;
     }
-    return std::fmax(0.0f, clockPeriod * multiplier);
+    if (offset > 0.5f * grid) {
+      offset -= grid;  // early, before the nearest beat
+    }
+    return std::fabs(offset) < BEAT_SNAP_WINDOW * grid ? duration - offset : duration;
   }
 
   inline float readBendDurationTimed(int channel) {
@@ -546,6 +948,9 @@ struct BendModule : rack::engine::Module {
   }
 };
 
+static_assert(alignof(BendModule) == DANT::CACHE_LINE, "BendModule state is laid out in cache lines");
+static_assert(sizeof(BendModule::BendLanes) == 6 * DANT::CACHE_LINE, "each lane state field must fill one cache line");
+
 static const std::string RESET_ARROW{"\uf56c"};
 static const std::string EXT_CLOCK{"\uf381"};
 static const std::string LENGTH_WATCH{"\uf2ca"};
@@ -602,6 +1007,9 @@ struct BendWidget : DANT::ModuleWidget {
     lengthKnob->vizType = DANT::KnobViz::UNIARC;
     lengthKnob->numNotches = 11;
     lengthKnob->inputId = BendModule::LENGTH_CV_INPUT;
+    if (module) {
+      lengthKnob->cvSnapshot = &module->cvSnapshot;
+    }
     lengthCvInputPort =
         rack::createInputCentered<DANT::Port>(DANT::layout(7.0f, 5.0f), module, BendModule::LENGTH_CV_INPUT);
     bendOrientationSwitch = rack::createParamCentered<rack::componentlibrary::CKSS>(DANT::layout(2.0f, 6.7f), module,
@@ -625,12 +1033,18 @@ struct BendWidget : DANT::ModuleWidget {
     bendAmountKnob->vizType = DANT::KnobViz::UNIARC;
     bendAmountKnob->numNotches = 5;
     bendAmountKnob->inputId = BendModule::BEND_AMOUNT_CV_INPUT;
+    if (module) {
+      bendAmountKnob->cvSnapshot = &module->cvSnapshot;
+    }
     bendAmountCvInputPort =
         rack::createInputCentered<DANT::Port>(DANT::layout(2.0f, 11.9f), module, BendModule::BEND_AMOUNT_CV_INPUT);
     bendShapeKnob =
         rack::createParamCentered<DANT::Knob>(DANT::layout(7.0f, 10.4f), module, BendModule::BEND_SHAPE_PARAM);
     bendShapeKnob->vizType = DANT::KnobViz::BIPARC;
     bendShapeKnob->inputId = BendModule::BEND_SHAPE_CV_INPUT;
+    if (module) {
+      bendShapeKnob->cvSnapshot = &module->cvSnapshot;
+    }
     bendShapeCvInputPort =
         rack::createInputCentered<DANT::Port>(DANT::layout(7.0f, 11.9f), module, BendModule::BEND_SHAPE_CV_INPUT);
     bendTrigButton = rack::createLightParamCentered<rack::componentlibrary::VCVLightButton<
@@ -641,8 +1055,7 @@ struct BendWidget : DANT::ModuleWidget {
     bendGridLight = rack::createWidgetCentered<DANT::GridLight>(DANT::layout(4.5f, 15.65f));
     bendGridLight->oneMode();
     if (module) {
-      bendGridLight->numChannels = &module->gridLightChannels;
-      bendGridLight->channelValues = module->gridLightValues;
+      bendGridLight->snapshot = &module->gridSnapshot;
     }
     signalsInputPort =
         rack::createInputCentered<DANT::Port>(DANT::layout(2.0f, 15.0f), module, BendModule::SIGNALS_INPUT);
@@ -676,8 +1089,7 @@ struct BendWidget : DANT::ModuleWidget {
     rack::app::ModuleWidget::addOutput(signalsOutputPort);
   }
 
-  void draw(const rack::widget::Widget::DrawArgs& args) override {
-    DANT::ModuleWidget::draw(args);
+  void drawPanelLabels(const rack::widget::Widget::DrawArgs& args) override {
     DANT::Fonts::DrawOptions opts;
     opts.align = NVG_ALIGN_MIDDLE | NVG_ALIGN_CENTER;
     opts.size = 20.0f;
@@ -741,29 +1153,70 @@ struct BendWidget : DANT::ModuleWidget {
     if (!module) return;
     menu->addChild(new rack::ui::MenuSeparator);
     menu->addChild(rack::createSubmenuItem("Unbend", "", [=](rack::ui::Menu* menu) {
-      menu->addChild(rack::createBoolPtrMenuItem("Unbend Envelope", "", &module->unbendEnvelope));
-      menu->addChild(rack::createBoolPtrMenuItem("Inverse Shape", "", &module->inverseUnbendShape));
-      auto* durSlider =
-          new DANT::MenuSlider(new DANT::FloatValueQuantity("Unbend Duration", 0.0f, 2.0f, 0.10f,
-                                                            &module->unbendDurationPct, "%", 100.0f, "%.0f"),
-                               DANT::RGB_SLIDER_WIDTH);
+      menu->addChild(rack::createBoolMenuItem(
+          "Unbend Envelope", "", [=]() { return module->getConfig().unbendEnvelope; },
+          [=](bool value) { module->setConfigValue(&BendModule::BendConfig::unbendEnvelope, value); }));
+      menu->addChild(rack::createBoolMenuItem(
+          "Inverse Shape", "", [=]() { return module->getConfig().inverseUnbendShape; },
+          [=](bool value) { module->setConfigValue(&BendModule::BendConfig::inverseUnbendShape, value); }));
+      auto* durSlider = new DANT::MenuSlider(
+          new DANT::FloatValueQuantity(
+              "Unbend Duration", 0.0f, 2.0f, 0.10f, [=]() { return module->getConfig().unbendDurationPct; },
+              [=](float value) { module->setConfigValue(&BendModule::BendConfig::unbendDurationPct, value); }, "%",
+              100.0f, "%.0f"),
+          DANT::RGB_SLIDER_WIDTH);
       menu->addChild(durSlider);
     }));
     menu->addChild(rack::createSubmenuItem("Hold Method", "", [=](rack::ui::Menu* menu) {
       auto addHoldMethodItem = [=](const std::string& name, BendModule::HoldMethod method) {
-        menu->addChild(rack::createMenuItem(name, module->holdMethod == method ? "✔" : "",
-                                            [=]() { module->holdMethod = method; }));
+        menu->addChild(rack::createMenuItem(name, module->getConfig().holdMethod == method ? "✔" : "", [=]() {
+          module->setConfigValue(&BendModule::BendConfig::holdMethod, method);
+        }));
       };
       addHoldMethodItem("Indefinite", BendModule::INDEFINITE);
       addHoldMethodItem("Auto-Unhold", BendModule::AUTO_UNHOLD);
-      auto* threshSlider =
-          new DANT::MenuSlider(new DANT::FloatValueQuantity("Threshold", 0.000833333f, 0.08333333f, 0.0f,
-                                                            &module->autoUnholdThreshold, " cents", 1200.0f, "%.0f"),
-                               DANT::RGB_SLIDER_WIDTH);
+      auto* threshSlider = new DANT::MenuSlider(
+          new DANT::FloatValueQuantity(
+              "Threshold", 0.000833333f, 0.08333333f, 0.0f, [=]() { return module->getConfig().autoUnholdThreshold; },
+              [=](float value) { module->setConfigValue(&BendModule::BendConfig::autoUnholdThreshold, value); },
+              " cents", 1200.0f, "%.0f"),
+          DANT::RGB_SLIDER_WIDTH);
       menu->addChild(threshSlider);
       addHoldMethodItem("Gate-Bends", BendModule::GATE_BENDS);
       addHoldMethodItem("Toggle Triggers", BendModule::TOGGLE_TRIGGERS);
     }));
+    menu->addChild(rack::createSubmenuItem("MIDI Input", "", [=](rack::ui::Menu* menu) {
+      menu->addChild(rack::createBoolMenuItem(
+          "Enabled", "", [=]() { return module->getConfig().midiEnabled; },
+          [=](bool value) { module->setConfigValue(&BendModule::BendConfig::midiEnabled, value); }));
+      menu->addChild(new rack::ui::MenuSeparator);
+      rack::app::appendMidiMenu(menu, &module->midiInput);
+      menu->addChild(new rack::ui::MenuSeparator);
+      const int current{module->getConfig().midiVoices};
+      menu->addChild(rack::createSubmenuItem("Polyphony", std::to_string(current), [=](rack::ui::Menu* menu) {
+        for (int voices{1}; voices <= DANT::CHANS; ++voices) {
+          menu->addChild(rack::createMenuItem(std::to_string(voices), current == voices ? "✔" : "", [=]() {
+            module->setConfigValue(&BendModule::BendConfig::midiVoices, voices);
+          }));
+        }
+      }));
+      menu->addChild(rack::createBoolMenuItem(
+          "Pitch Wheel to Bend Amount", "", [=]() { return module->getConfig().wheelToAmount; },
+          [=](bool value) { module->setConfigValue(&BendModule::BendConfig::wheelToAmount, value); }));
+      menu->addChild(rack::createBoolMenuItem(
+          "Aftertouch to Bend Amount", "", [=]() { return module->getConfig().aftertouchToAmount; },
+          [=](bool value) { module->setConfigValue(&BendModule::BendConfig::aftertouchToAmount, value); }));
+    }));
+    menu->addChild(rack::createBoolMenuItem(
+        "Sub-sample Trigger Timing", "", [=]() { return module->getConfig().subSampleOnset; },
+        [=](bool value) { module->setConfigValue(&BendModule::BendConfig::subSampleOnset, value); }));
+    menu->addChild(rack::createBoolMenuItem(
+        "Snap Clocked Bends to the Beat", "", [=]() { return module->getConfig().snapToBeat; },
+        [=](bool value) { module->setConfigValue(&BendModule::BendConfig::snapToBeat, value); }));
+    DANT::appendChainMenu(menu, &module->chain);
+    DANT::appendMonoBlockMenu(
+        menu, [=]() { return module->getConfig().monoBlockMode; },
+        [=](bool value) { module->setConfigValue(&BendModule::BendConfig::monoBlockMode, value); });
   }
 };
 
@@ -7,6 +7,10 @@ void init(rack::plugin::Plugin* p) {
 
   p->addModel(modelAocr);
   p->addModel(modelBend);
+  p->addModel(modelBendExpander);
+
+  // Eco mode has to apply before any module runs, not only once an AOCR loads the settings with its patch data
+  DANT::loadUserSettings();
 }
 
 float DANT::PANEL_R_B{DANT::DEFAULT_R_B};
@@ -15,6 +19,7 @@ float DANT::PANEL_B_B{DANT::DEFAULT_B_B};
 float DANT::PANEL_R_D{DANT::DEFAULT_R_D};
 float DANT::PANEL_G_D{DANT::DEFAULT_G_D};
 float DANT::PANEL_B_D{DANT::DEFAULT_B_D};
+std::atomic<bool> DANT::ECO_MODE{DANT::DEFAULT_ECO_MODE};
 
 namespace DANT {
 rack::math::Vec layout(const float column, const float row) {
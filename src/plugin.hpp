@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <rack.hpp>
 #include <string>
 
@@ -9,6 +10,7 @@ extern rack::plugin::Plugin* pluginInstance;
 
 extern rack::plugin::Model* modelAocr;
 extern rack::plugin::Model* modelBend;
+extern rack::plugin::Model* modelBendExpander;
 
 /**
  * Layout variables, _X is half a HP. Add widgets centred at x position HP * 2 - 1.
@@ -28,6 +30,7 @@ extern float PANEL_B_B;  // panel blue bright
 extern float PANEL_R_D;  // panel red dark
 extern float PANEL_G_D;  // panel green dark
 extern float PANEL_B_D;  // panel blue dark
+extern std::atomic<bool> ECO_MODE;  // cheaper processing in every module, set by the UI thread
 
 // Common icons
 static const std::string INPUT_CIRCLE{"\uf71a"};
@@ -40,6 +43,7 @@ static const float DEFAULT_B_B{238.0f};
 static const float DEFAULT_R_D{48.0f};
 static const float DEFAULT_G_D{48.0f};
 static const float DEFAULT_B_D{48.0f};
+static const bool DEFAULT_ECO_MODE{false};
 
 // Plugin shared settings
 static const std::string PLUGIN_SETTINGS_FILENAME{"DanTSynth.json"};
@@ -74,6 +78,7 @@ inline void saveUserSettings() {
   json_object_set_new(rootJ, "panelDarkRed", json_integer(static_cast<int>(DANT::PANEL_R_D)));
   json_object_set_new(rootJ, "panelDarkGreen", json_integer(static_cast<int>(DANT::PANEL_G_D)));
   json_object_set_new(rootJ, "panelDarkBlue", json_integer(static_cast<int>(DANT::PANEL_B_D)));
+  json_object_set_new(rootJ, "ecoMode", json_boolean(DANT::ECO_MODE.load()));
 
   DANT::saveSettings(rootJ);
 }
@@ -87,6 +92,7 @@ inline void loadUserSettings() {
   json_t* pdrJ = json_object_get(settingsJ, "panelDarkRed");
   json_t* pdgJ = json_object_get(settingsJ, "panelDarkGreen");
   json_t* pdbJ = json_object_get(settingsJ, "panelDarkBlue");
+  json_t* ecoJ = json_object_get(settingsJ, "ecoMode");
 
   DANT::PANEL_R_B = pbrJ ? static_cast<float>(json_integer_value(pbrJ)) : DANT::DEFAULT_R_B;
   DANT::PANEL_G_B = pbgJ ? static_cast<float>(json_integer_value(pbgJ)) : DANT::DEFAULT_G_B;
@@ -94,6 +100,7 @@ inline void loadUserSettings() {
   DANT::PANEL_R_D = pdrJ ? static_cast<float>(json_integer_value(pdrJ)) : DANT::DEFAULT_R_D;
   DANT::PANEL_G_D = pdgJ ? static_cast<float>(json_integer_value(pdgJ)) : DANT::DEFAULT_G_D;
   DANT::PANEL_B_D = pdbJ ? static_cast<float>(json_integer_value(pdbJ)) : DANT::DEFAULT_B_D;
+  DANT::ECO_MODE.store(ecoJ ? json_boolean_value(ecoJ) : DANT::DEFAULT_ECO_MODE);
 }
 
 }  // namespace DANT
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "../plugin.hpp"
+
+namespace DANT {
+
+static const std::string REGULAR_TTF{"fonts/CourierPrime-Regular.ttf"};
+static const std::string BOLD_TTF{"fonts/CourierPrime-Bold.ttf"};
+static const std::string SYMBOLS_TTF{"fonts/MaterialSymbolsSharp[FILL,GRAD,opsz,wght].ttf"};
+
+/**
+ * Plugin wide asset registry.
+ * Every plugin asset path is resolved once, widgets pass the paths to the window loaders instead of building them
+ * per widget or per draw.
+ * Only paths are kept here, the loaded SVGs, images and fonts stay owned by the window and its cache.
+ */
+struct Assets {
+  std::string gridBg;
+  std::string knobBg;
+  std::string knobFg;
+  std::string port;
+  std::string trimpotBg;
+  std::string trimpotFg;
+  std::string metalGrad;
+  std::map<std::string, std::string> fonts;
+
+  double resolveMilliseconds{0.0};  // time spent resolving the paths, reported in the log
+
+  static const Assets& get() {
+    static const Assets assets;
+    return assets;
+  }
+
+  std::string font(const std::string& ttfFile) const {
+    auto found = this->fonts.find(ttfFile);
+    if (found != this->fonts.end()) {
+      return found->second;
+    }
+    return rack::asset::plugin(pluginInstance, ttfFile);  // not one of the preloaded fonts
+  }
+
+ private:
+  Assets() {
+    const double start{rack::system::getTime()};
+
+    this->gridBg = rack::asset::plugin(pluginInstance, "res/grid-bg.svg");
+    this->knobBg = rack::asset::plugin(pluginInstance, "res/knob-bg.svg");
+    this->knobFg = rack::asset::plugin(pluginInstance, "res/knob-fg.svg");
+    this->port = rack::asset::plugin(pluginInstance, "res/port.svg");
+    this->trimpotBg = rack::asset::plugin(pluginInstance, "res/trimpot-bg.svg");
+    this->trimpotFg = rack::asset::plugin(pluginInstance, "res/trimpot-fg.svg");
+    this->metalGrad = rack::asset::plugin(pluginInstance, "res/metal-grad.png");
+    for (const std::string& ttfFile : {REGULAR_TTF, BOLD_TTF, SYMBOLS_TTF}) {
+      this->fonts[ttfFile] = rack::asset::plugin(pluginInstance, ttfFile);
+    }
+
+    this->resolveMilliseconds = (rack::system::getTime() - start) * 1000.0;
+    INFO("DanT asset paths resolved in %.3f ms", this->resolveMilliseconds);
+  }
+};
+
+}  // namespace DANT
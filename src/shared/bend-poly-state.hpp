@@ -0,0 +1,52 @@
+#pragma once
+
+#include <rack.hpp>
+
+#include "../dsp/cache-line.hpp"
+#include "../dsp/lane-mask.hpp"
+#include "../static.hpp"
+
+namespace DANT {
+
+/**
+ * A Bend's per channel state after a sample, sent to the module on its right.
+ */
+struct alignas(DANT::CACHE_LINE) BendPolyState {
+  rack::simd::float_4 progress[DANT::SIMD]{};  // 0 to 1 through the bend or unbend, 1 while holding
+  rack::simd::float_4 envelope[DANT::SIMD]{};  // the bend's curve, see DANT::bendEnvelope
+  DANT::LaneMask bending;
+  DANT::LaneMask holding;    // reached the target, waiting to unhold
+  DANT::LaneMask unbending;  // returning to the input pitch
+  DANT::LaneMask ended;      // bends that ended this sample, returned or reset
+  int channels{0};
+};
+
+/**
+ * Mixin for modules that read the state of a Bend on their left, found by Bend with a dynamic_cast.
+ * The reader owns both messages: Bend writes the producer message every sample while the reader reads the consumer
+ * message, the engine flips them after every frame, so the state arrives a sample later.
+ */
+struct BendStateReader {
+  // points the module's left expander at the states, from the module constructor
+  void attachBendState(rack::engine::Module& module) {
+    module.leftExpander.producerMessage = &this->bendStates[0];
+    module.leftExpander.consumerMessage = &this->bendStates[1];
+  }
+
+  // the state the Bend on the left sent last frame, no channels when there isn't one
+  const DANT::BendPolyState& bendState(const rack::engine::Module& module) const {
+    return *static_cast<const DANT::BendPolyState*>(module.leftExpander.consumerMessage);
+  }
+
+  // the module on the left changed, so a state it didn't send isn't read, from onExpanderChange
+  void clearBendState() {
+    for (DANT::BendPolyState& state : this->bendStates) {
+      state = DANT::BendPolyState();
+    }
+  }
+
+ private:
+  DANT::BendPolyState bendStates[2];
+};
+
+}  // namespace DANT
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <rack.hpp>
+#include <string>
+
+#include "../plugin.hpp"
+#include "capture.hpp"
+
+namespace DANT {
+
+static const std::string CAPTURE_DIR{"DanTSynth/captures"};
+
+/**
+ * Developer mode context menu item that starts or stops capturing a module's inputs.
+ * Captures are written to the Rack user folder, named after the module slug and the start time.
+ * A capture that can't start is shown disabled, with the reason, see Captured::captureBlocked().
+ */
+inline void appendCaptureMenu(rack::ui::Menu* menu, DANT::Capture* capture, rack::engine::Module* module,
+                              const std::string& slug, const std::string& blocked = "") {
+  if (capture->isActive()) {
+    const std::string frames{rack::string::f("%llu frames", static_cast<unsigned long long>(capture->getFrames()))};
+    menu->addChild(rack::createMenuItem("Stop input capture", frames, [=]() {
+      capture->stop();
+      INFO("DanT capture %s: %llu frames, %llu dropped", capture->getPath().c_str(),
+           static_cast<unsigned long long>(capture->getFrames()),
+           static_cast<unsigned long long>(capture->getDropped()));
+    }));
+    return;
+  }
+  if (!blocked.empty()) {
+    menu->addChild(rack::createMenuItem("Start input capture", blocked, nullptr, true));
+    return;
+  }
+  menu->addChild(rack::createMenuItem("Start input capture", "", [=]() {
+    const std::string dir{rack::asset::user(DANT::CAPTURE_DIR)};
+    rack::system::createDirectories(dir);
+    const std::string path{rack::system::join(
+        dir, rack::string::f("%s-%lld%s", slug.c_str(), static_cast<long long>(rack::system::getUnixTime()),
+                             DANT::CAPTURE_EXTENSION))};
+    if (capture->start(path, slug, APP->engine->getSampleRate(), *module)) {
+      INFO("DanT capture started: %s", path.c_str());
+    } else {
+      WARN("DanT capture could not start: %s", path.c_str());
+    }
+  }));
+}
+
+}  // namespace DANT
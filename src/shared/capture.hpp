@@ -0,0 +1,375 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>  // std::memcmp, std::memcpy
+#include <memory>
+#include <rack.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../dsp/cache-line.hpp"
+#include "../static.hpp"
+
+namespace DANT {
+
+/**
+ * Input capture file format, little endian.
+ * A CaptureHeader, then one record per frame, or one record for a run of unchanged frames:
+ * - uint32 mask with CAPTURE_REPEAT_BIT set, the low bits count frames identical to the previous frame.
+ * - uint32 change mask, bit p for each changed param p, bit numParams + i for each changed input i,
+ *   then a float per changed param, then per changed input a uint8 channel count and a float per channel.
+ * The first frame has every bit set.
+ */
+static const int CAPTURE_MAX_PARAMS{16};
+static const int CAPTURE_MAX_INPUTS{15};  // params and inputs share a 31 bit change mask
+static const uint32_t CAPTURE_REPEAT_BIT{0x80000000u};
+static const uint32_t CAPTURE_VERSION{1u};
+static const char CAPTURE_MAGIC[8]{'D', 'A', 'N', 'T', 'C', 'A', 'P', '1'};
+static const char* const CAPTURE_EXTENSION{".dantcap"};
+
+struct CaptureHeader {
+  char magic[8];
+  uint32_t version;
+  float sampleRate;
+  uint16_t numParams;
+  uint16_t numInputs;
+  char slug[32];  // module slug, null terminated
+};
+static_assert(sizeof(CaptureHeader) == 52, "CaptureHeader is written as is");
+
+// one frame of a module's params and inputs
+struct CaptureFrame {
+  float params[CAPTURE_MAX_PARAMS];
+  uint8_t channels[CAPTURE_MAX_INPUTS];
+  float voltages[CAPTURE_MAX_INPUTS][DANT::CHANS];
+};
+
+inline CaptureHeader captureHeader(const std::string& slug, const float sampleRate, const int numParams,
+                                   const int numInputs) {
+  CaptureHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+  header.version = CAPTURE_VERSION;
+  header.sampleRate = sampleRate;
+  header.numParams = static_cast<uint16_t>(numParams);
+  header.numInputs = static_cast<uint16_t>(numInputs);
+  std::strncpy(header.slug, slug.c_str(), sizeof(header.slug) - 1);
+  return header;
+}
+
+// resolved, when set, is captured in place of input resolvedId, for an input the module reads from elsewhere
+inline void captureFrame(const rack::engine::Module& module, CaptureFrame& frame, const int resolvedId = -1,
+                         const rack::engine::Input* resolved = nullptr) {
+  for (size_t p{0}; p < module.params.size(); ++p) {
+    frame.params[p] = module.params[p].value;
+  }
+  for (size_t i{0}; i < module.inputs.size(); ++i) {
+    const rack::engine::Input& input{static_cast<int>(i) == resolvedId && resolved ? *resolved : module.inputs[i]};
+    frame.channels[i] = input.channels;
+    std::memcpy(frame.voltages[i], input.voltages, sizeof(frame.voltages[i]));
+  }
+}
+
+// sets the module's params and inputs, the inverse of captureFrame
+inline void applyFrame(const CaptureFrame& frame, rack::engine::Module& module) {
+  for (size_t p{0}; p < module.params.size(); ++p) {
+    module.params[p].setValue(frame.params[p]);
+  }
+  for (size_t i{0}; i < module.inputs.size(); ++i) {
+    module.inputs[i].channels = frame.channels[i];
+    std::memcpy(module.inputs[i].voltages, frame.voltages[i], sizeof(frame.voltages[i]));
+  }
+}
+
+/**
+ * Packs frames into records, only the params and inputs that changed since the previous frame are written.
+ */
+struct CaptureEncoder {
+  CaptureEncoder(const int numParams, const int numInputs) : numParams(numParams), numInputs(numInputs) {}
+
+  void encode(const CaptureFrame& frame, std::vector<uint8_t>& out) {
+    uint32_t mask{0u};
+    for (int p{0}; p < this->numParams; ++p) {
+      if (!this->hasPrevious || std::memcmp(&frame.params[p], &this->previous.params[p], sizeof(float)) != 0) {
+        mask |= 1u << p;
+      }
+    }
+    for (int i{0}; i < this->numInputs; ++i) {
+      if (!this->hasPrevious || frame.channels[i] != this->previous.channels[i] ||
+          std::memcmp(frame.voltages[i], this->previous.voltages[i], frame.channels[i] * sizeof(float)) != 0) {
+        mask |= 1u << (this->numParams + i);
+      }
+    }
+    if (mask == 0u) {
+      if (++this->repeats == ~CAPTURE_REPEAT_BIT) {
+        flush(out);
+      }
+      return;
+    }
+    flush(out);
+    append(out, &mask, sizeof(mask));
+    for (int p{0}; p < this->numParams; ++p) {
+      if (mask & (1u << p)) {
+        append(out, &frame.params[p], sizeof(float));
+      }
+    }
+    for (int i{0}; i < this->numInputs; ++i) {
+      if (mask & (1u << (this->numParams + i))) {
+        append(out, &frame.channels[i], sizeof(uint8_t));
+        append(out, frame.voltages[i], frame.channels[i] * sizeof(float));
+      }
+    }
+    this->previous = frame;
+    this->hasPrevious = true;
+  }
+
+  // writes the pending run of unchanged frames, call before closing the file
+  void flush(std::vector<uint8_t>& out) {
+    if (this->repeats > 0u) {
+      const uint32_t record{CAPTURE_REPEAT_BIT | this->repeats};
+      append(out, &record, sizeof(record));
+      this->repeats = 0u;
+    }
+  }
+
+ private:
+  const int numParams;
+  const int numInputs;
+  CaptureFrame previous;
+  bool hasPrevious{false};
+  uint32_t repeats{0u};
+
+  static void append(std::vector<uint8_t>& out, const void* data, const size_t size) {
+    const uint8_t* bytes{static_cast<const uint8_t*>(data)};
+    out.insert(out.end(), bytes, bytes + size);
+  }
+};
+
+/**
+ * Unpacks the frames of a capture held in memory, e.g. a memory mapped file.
+ */
+struct CaptureDecoder {
+  // false if the data is not a capture this version can read
+  bool open(const uint8_t* data, const size_t size) {
+    if (size < sizeof(CaptureHeader)) {
+      return false;
+    }
+    std::memcpy(&this->header, data, sizeof(CaptureHeader));
+    if (std::memcmp(this->header.magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0 ||
+        this->header.version != CAPTURE_VERSION || this->header.numParams > CAPTURE_MAX_PARAMS ||
+        this->header.numInputs > CAPTURE_MAX_INPUTS) {
+      return false;
+    }
+    this->header.slug[sizeof(this->header.slug) - 1] = '\0';
+    this->data = data;
+    this->size = size;
+    this->position = sizeof(CaptureHeader);
+    this->repeats = 0u;
+    std::memset(&this->frame, 0, sizeof(this->frame));
+    return true;
+  }
+
+  const CaptureHeader& getHeader() const { return this->header; }
+
+  // false at the end of the capture, or at a truncated record
+  bool next(CaptureFrame& out) {
+    if (this->repeats > 0u) {
+      --this->repeats;
+      out = this->frame;
+      return true;
+    }
+    uint32_t mask;
+    if (!read(&mask, sizeof(mask))) {
+      return false;
+    }
+    if (mask & CAPTURE_REPEAT_BIT) {
+      if ((mask & ~CAPTURE_REPEAT_BIT) == 0u) {
+        return false;  // never written, the data is corrupt
+      }
+      this->repeats = (mask & ~CAPTURE_REPEAT_BIT) - 1u;
+      out = this->frame;
+      return true;
+    }
+    for (int p{0}; p < this->header.numParams; ++p) {
+      if ((mask & (1u << p)) && !read(&this->frame.params[p], sizeof(float))) {
+        return false;
+      }
+    }
+    for (int i{0}; i < this->header.numInputs; ++i) {
+      if (mask & (1u << (this->header.numParams + i))) {
+        if (!read(&this->frame.channels[i], sizeof(uint8_t)) || this->frame.channels[i] > DANT::CHANS ||
+            !read(this->frame.voltages[i], this->frame.channels[i] * sizeof(float))) {
+          return false;
+        }
+      }
+    }
+    out = this->frame;
+    return true;
+  }
+
+ private:
+  CaptureHeader header;
+  const uint8_t* data{nullptr};
+  size_t size{0};
+  size_t position{0};
+  uint32_t repeats{0u};
+  CaptureFrame frame;
+
+  bool read(void* out, const size_t bytes) {
+    if (this->position + bytes > this->size) {
+      return false;
+    }
+    std::memcpy(out, this->data + this->position, bytes);
+    this->position += bytes;
+    return true;
+  }
+};
+
+/**
+ * Records a module's params and inputs every frame to a capture file, for replaying offline.
+ * The audio thread copies frames into a lock-free single producer, single consumer ring,
+ * a writer thread packs them and writes the file, frames are dropped and counted if the ring is full.
+ * start() and stop() are called from the UI thread.
+ */
+struct Capture {
+  static const uint32_t RING_FRAMES{4096u};  // ~85ms at 48kHz, power of 2
+
+  ~Capture() { stop(); }
+
+  bool isActive() const { return this->active.load(std::memory_order_acquire); }
+
+  const std::string& getPath() const { return this->path; }
+
+  uint64_t getFrames() const { return this->frames.load(std::memory_order_relaxed); }
+
+  uint64_t getDropped() const { return this->dropped.load(std::memory_order_relaxed); }
+
+  bool start(const std::string& path, const std::string& slug, const float sampleRate,
+             const rack::engine::Module& module) {
+    stop();
+    if (module.params.size() > static_cast<size_t>(CAPTURE_MAX_PARAMS) ||
+        module.inputs.size() > static_cast<size_t>(CAPTURE_MAX_INPUTS)) {
+      return false;
+    }
+    this->file = std::fopen(path.c_str(), "wb");
+    if (!this->file) {
+      return false;
+    }
+    const CaptureHeader header{captureHeader(slug, sampleRate, static_cast<int>(module.params.size()),
+                                             static_cast<int>(module.inputs.size()))};
+    std::fwrite(&header, sizeof(header), 1, this->file);
+    if (!this->ring) {
+      this->ring.reset(new CaptureFrame[RING_FRAMES]);
+    }
+    this->path = path;
+    this->numParams = header.numParams;
+    this->numInputs = header.numInputs;
+    this->head.store(0u, std::memory_order_relaxed);
+    this->tail.store(0u, std::memory_order_relaxed);
+    this->frames.store(0u, std::memory_order_relaxed);
+    this->dropped.store(0u, std::memory_order_relaxed);
+    this->stopping.store(false, std::memory_order_relaxed);
+    this->writer = std::thread([this]() { writeLoop(); });
+    this->active.store(true, std::memory_order_release);
+    return true;
+  }
+
+  // waits for the audio thread to leave record() and the writer to finish the file
+  void stop() {
+    if (!this->writer.joinable()) {
+      return;
+    }
+    this->active.store(false, std::memory_order_seq_cst);
+    while (this->recording.load(std::memory_order_seq_cst)) {
+      std::this_thread::yield();
+    }
+    this->stopping.store(true, std::memory_order_release);
+    this->writer.join();
+  }
+
+  // audio thread, call at the top of process() so the frame holds the values process() sees,
+  // resolved is what the module reads in place of input resolvedId, e.g. a chained module's signal
+  void record(const rack::engine::Module& module, const int resolvedId = -1,
+              const rack::engine::Input* resolved = nullptr) {
+    if (!this->active.load(std::memory_order_acquire)) {
+      return;
+    }
+    this->recording.store(true, std::memory_order_seq_cst);
+    if (this->active.load(std::memory_order_seq_cst)) {
+      const uint32_t headIndex{this->head.load(std::memory_order_relaxed)};
+      if (headIndex - this->tail.load(std::memory_order_acquire) >= RING_FRAMES) {
+        this->dropped.store(getDropped() + 1u, std::memory_order_relaxed);
+      } else {
+        captureFrame(module, this->ring[headIndex & (RING_FRAMES - 1u)], resolvedId, resolved);
+        this->head.store(headIndex + 1u, std::memory_order_release);
+        this->frames.store(getFrames() + 1u, std::memory_order_relaxed);
+      }
+    }
+    this->recording.store(false, std::memory_order_release);
+  }
+
+ private:
+  std::unique_ptr<CaptureFrame[]> ring;
+  // written by the audio thread, on a cache line of their own
+  alignas(DANT::CACHE_LINE) std::atomic<uint32_t> head{0u};
+  std::atomic<bool> recording{false};
+  std::atomic<uint64_t> frames{0u};
+  std::atomic<uint64_t> dropped{0u};
+  // written by the writer thread
+  alignas(DANT::CACHE_LINE) std::atomic<uint32_t> tail{0u};
+  // written by the UI thread
+  alignas(DANT::CACHE_LINE) std::atomic<bool> active{false};
+  std::atomic<bool> stopping{false};
+  std::thread writer;
+  std::FILE* file{nullptr};
+  std::string path;
+  int numParams{0};
+  int numInputs{0};
+
+  void writeLoop() {
+    CaptureEncoder encoder(this->numParams, this->numInputs);
+    std::vector<uint8_t> packed;
+    packed.reserve(1u << 16);
+    while (true) {
+      // read before draining, everything recorded before stop() is in the ring by the time stopping is set
+      const bool finishing{this->stopping.load(std::memory_order_acquire)};
+      uint32_t tailIndex{this->tail.load(std::memory_order_relaxed)};
+      const uint32_t headIndex{this->head.load(std::memory_order_acquire)};
+      while (tailIndex != headIndex) {
+        encoder.encode(this->ring[tailIndex & (RING_FRAMES - 1u)], packed);
+        this->tail.store(++tailIndex, std::memory_order_release);
+      }
+      if (finishing) {
+        break;
+      }
+      if (!packed.empty()) {
+        std::fwrite(packed.data(), 1, packed.size(), this->file);
+        packed.clear();
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    encoder.flush(packed);
+    std::fwrite(packed.data(), 1, packed.size(), this->file);
+    std::fclose(this->file);
+    this->file = nullptr;
+  }
+};
+
+/**
+ * Mixin for modules that can capture their inputs, found by the common widget code with a dynamic_cast.
+ * The capture menu is only shown in Rack's developer mode.
+ */
+struct Captured {
+  DANT::Capture capture;
+
+  virtual ~Captured() = default;
+
+  // UI thread, why a capture can't start, e.g. inputs that aren't read from the ports, empty when it can
+  virtual std::string captureBlocked() const { return ""; }
+};
+
+}  // namespace DANT
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <rack.hpp>
+
+#include "expander-chain.hpp"
+
+namespace DANT {
+
+/**
+ * Context menu item that turns a module's chaining on and off, see DANT::ExpanderChain.
+ */
+inline void appendChainMenu(rack::ui::Menu* menu, DANT::ExpanderChain* chain) {
+  menu->addChild(rack::createBoolMenuItem(
+      "Chain Signal from Left Module", "", [=]() { return chain->isEnabled(); },
+      [=](bool enable) { chain->setEnabled(enable); }));
+}
+
+}  // namespace DANT
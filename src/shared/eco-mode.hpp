@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "../plugin.hpp"
+#include "snapshot.hpp"
+
+namespace DANT {
+
+static const uint32_t ECO_CV_DIVISION{16};  // samples between CV reads in Eco mode, 3kHz at 48kHz
+
+/**
+ * The audio thread's view of the plugin wide Eco mode setting, updated once per sample.
+ * In Eco mode modules read their CVs at control rate and publish display state less often.
+ */
+struct EcoMode {
+  bool enabled{false};
+
+  // takes the current setting, returns true when it changed
+  bool update() {
+    const bool eco{DANT::ECO_MODE.load(std::memory_order_relaxed)};
+    if (eco == this->enabled) {
+      return false;
+    }
+    this->enabled = eco;
+    this->cvCountdown = 0u;  // read the CVs straight away
+    return true;
+  }
+
+  // true on the samples CVs are read, every sample unless in Eco mode
+  bool readCvs() {
+    if (this->cvCountdown > 0u) {
+      --this->cvCountdown;
+      return false;
+    }
+    this->cvCountdown = this->enabled ? ECO_CV_DIVISION - 1u : 0u;
+    return true;
+  }
+
+  uint32_t snapshotDivision() const { return this->enabled ? ECO_SNAPSHOT_DIVISION : SNAPSHOT_DIVISION; }
+
+ private:
+  uint32_t cvCountdown{0u};
+};
+
+}  // namespace DANT
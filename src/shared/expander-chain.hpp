@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>  // std::copy
+#include <atomic>
+#include <rack.hpp>
+
+#include "../dsp/cache-line.hpp"
+#include "../static.hpp"
+
+namespace DANT {
+
+/**
+ * A poly signal sent to the module on the right, read by it in place of an input port, on a cache line of its own.
+ */
+struct alignas(DANT::CACHE_LINE) ChainMessage {
+  rack::engine::Input signal;
+};
+
+/**
+ * Chains the signal of adjacent DanT modules through Rack's expander messages, so a chain of modules placed side by
+ * side needs no cables. Each module sends its signal output to a chained module directly to its right, which reads
+ * it as its signal input while nothing is patched into it.
+ * Off unless the receiving module has chaining enabled from its context menu, so placing modules side by side doesn't
+ * change what a patch sounds like.
+ * The receiving module owns both messages: the sender writes the producer message while the receiver reads the
+ * consumer message, the engine flips them after every frame. The signal arrives a sample later, like a cable's.
+ */
+struct ExpanderChain {
+  // points the module's left expander at the messages, from the module constructor
+  void attach(rack::engine::Module& module) {
+    module.leftExpander.producerMessage = &this->messages[0];
+    module.leftExpander.consumerMessage = &this->messages[1];
+  }
+
+  // follows the modules placed next to the module, from onExpanderChange
+  inline void link(rack::engine::Module& module);
+
+  // the signal from the chained module on the left, or the patched input when it has a cable or nothing is chained
+  rack::engine::Input& input(const rack::engine::Module& module, rack::engine::Input& patched) const {
+    if (!this->chainedLeft || !isEnabled() || patched.isConnected()) {
+      return patched;
+    }
+    return static_cast<DANT::ChainMessage*>(module.leftExpander.consumerMessage)->signal;
+  }
+
+  // sends the output to the module on the right, every frame while it has chaining enabled
+  void send(const rack::engine::Module& module, const rack::engine::Output& output) const {
+    if (this->right == nullptr || !this->right->isEnabled()) {
+      return;
+    }
+    rack::engine::Module::Expander& expander = module.rightExpander.module->leftExpander;
+    rack::engine::Input& signal = static_cast<DANT::ChainMessage*>(expander.producerMessage)->signal;
+    std::copy(output.voltages, output.voltages + output.channels, signal.voltages);
+    signal.channels = output.channels;
+    expander.requestMessageFlip();
+  }
+
+  bool isChainedLeft() const { return this->chainedLeft; }
+
+  bool isChainedRight() const { return this->right != nullptr; }
+
+  // read from the chained module on the left instead of an unpatched input, off by default
+  bool isEnabled() const { return this->enabled.load(std::memory_order_acquire); }
+
+  // UI thread, from the context menu or the patch, the messages are cleared so a stale signal is never read
+  void setEnabled(const bool enable) {
+    if (enable && !isEnabled()) {
+      for (DANT::ChainMessage& message : this->messages) {
+        message.signal.channels = 0;
+      }
+    }
+    this->enabled.store(enable, std::memory_order_release);
+  }
+
+ private:
+  DANT::ChainMessage messages[2];
+  bool chainedLeft{false};
+  const ExpanderChain* right{nullptr};  // of the chained module on the right
+  std::atomic<bool> enabled{false};
+};
+
+/**
+ * Mixin for modules that chain their signal, found in their neighbours with a dynamic_cast.
+ */
+struct Chained {
+  DANT::ExpanderChain chain;
+};
+
+inline void ExpanderChain::link(rack::engine::Module& module) {
+  const bool left{dynamic_cast<DANT::Chained*>(module.leftExpander.module) != nullptr};
+  if (left != this->chainedLeft) {
+    // so a new neighbour doesn't start from the last signal of the one before
+    for (DANT::ChainMessage& message : this->messages) {
+      message.signal.channels = 0;
+    }
+  }
+  this->chainedLeft = left;
+  const DANT::Chained* right{dynamic_cast<DANT::Chained*>(module.rightExpander.module)};
+  this->right = right != nullptr ? &right->chain : nullptr;
+}
+
+}  // namespace DANT
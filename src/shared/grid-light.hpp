@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>  // std::fill
+
 #include "../plugin.hpp"
+#include "assets.hpp"
 #include "colours.hpp"
+#include "snapshot.hpp"
 
 namespace DANT {
 static const float GRID_EDGE{1.0f};
@@ -9,8 +13,7 @@ static const float GRID_CELL{2.0f};
 static const float GRID_SPACING{1.0f};
 
 struct GridLight : rack::widget::SvgWidget {
-  const int* numChannels{nullptr};
-  const rack::simd::float_4* channelValues{nullptr};  // pointer to array of simd floats
+  const DANT::Snapshot<DANT::GridLightState>* snapshot{nullptr};  // published by the module, null in the browser
 
   float minChannelValue{-5.0f};  // full intensity negative light at this value
   float maxChannelValue{5.0f};   // full intensity positive light at this value
@@ -18,7 +21,7 @@ struct GridLight : rack::widget::SvgWidget {
   NVGcolor negativeColour{DANT::RGB_CV_RED};
   NVGcolor positiveColour{DANT::RGB_CV_GREEN};
 
-  GridLight() { this->setSvg(APP->window->loadSvg(rack::asset::plugin(pluginInstance, "res/grid-bg.svg"))); }
+  GridLight() { this->setSvg(APP->window->loadSvg(DANT::Assets::get().gridBg)); }
 
   void fullMode() {  // any signals
     this->minChannelValue = -10.0f;
@@ -40,20 +43,15 @@ struct GridLight : rack::widget::SvgWidget {
     this->maxChannelValue = 1.0f;
   }
 
-  int getNumChannels() {
-    if (this->numChannels == nullptr) {
-      return DANT::CHANS;
-    } else {
-      return *this->numChannels;
-    }
-  }
-
-  float getChannelValue(const int chanIndex) {
-    if (this->channelValues == nullptr) {
-      return this->maxChannelValue;
-    } else {
-      return this->channelValues[DANT::SIMD_I[chanIndex]][DANT::SIMD_J[chanIndex]];
+  DANT::GridLightState readState() {
+    if (this->snapshot == nullptr) {
+      DANT::GridLightState preview;
+      preview.numChannels = DANT::CHANS;
+      std::fill(preview.peak, preview.peak + DANT::SIMD, rack::simd::float_4(this->maxChannelValue));
+      std::fill(preview.rms, preview.rms + DANT::SIMD, rack::simd::float_4(this->maxChannelValue));
+      return preview;
     }
+    return this->snapshot->read();
   }
 
   void draw(const rack::widget::Widget::DrawArgs& args) override {
@@ -72,38 +70,59 @@ struct GridLight : rack::widget::SvgWidget {
     }
   }
 
+  // the RMS lights the cell, the peak its outline
   void channelLoop(const rack::widget::Widget::DrawArgs& args, const bool placeholders = false) {
+    const DANT::GridLightState state{readState()};  // one consistent copy per frame
     int channel{0};
     for (int x{0}; x < DANT::SIMD; ++x) {
       for (int y{0}; y < DANT::SIMD; ++y) {
         channel = (x * DANT::SIMD) + (y + 1);
-        if (channel <= getNumChannels()) {
-          NVGcolor colour{DANT::RGB_UNLIT};
+        if (channel <= state.numChannels) {
+          NVGcolor rmsColour{DANT::RGB_UNLIT};
+          NVGcolor peakColour{DANT::RGB_UNLIT};
+          peakColour.a = 0.0f;
           if (!placeholders) {
-            float chanValue{getChannelValue(channel - 1)};
-            if (chanValue != 0.0f) {
-              colour = chanValue < 0.0f ? this->negativeColour : this->positiveColour;
-              colour.a = chanValue < 0.0f ? (chanValue / this->minChannelValue) : (chanValue / this->maxChannelValue);
-            } else {
-              // Properly zeroes out alpha for empty lanes overlaid on placeholders
-              colour.a = 0.0f;
-            }
+            const int i{DANT::SIMD_I[channel - 1]};
+            const int j{DANT::SIMD_J[channel - 1]};
+            rmsColour = levelColour(state.rms[i][j]);
+            peakColour = levelColour(state.peak[i][j]);
           }
           drawChanSquare(args,
                          rack::math::Vec(GRID_EDGE + ((x + 1) * GRID_SPACING) + (x * GRID_CELL),
                                          GRID_EDGE + ((y + 1) * GRID_SPACING) + (y * GRID_CELL)),
-                         colour);
+                         rmsColour, peakColour);
         }
       }
     }
   }
 
-  void drawChanSquare(const rack::widget::Widget::DrawArgs& args, const rack::math::Vec pos, const NVGcolor colour) {
+  NVGcolor levelColour(const float chanValue) const {
+    if (chanValue == 0.0f) {
+      // Properly zeroes out alpha for empty lanes overlaid on placeholders
+      NVGcolor colour{DANT::RGB_UNLIT};
+      colour.a = 0.0f;
+      return colour;
+    }
+    NVGcolor colour{chanValue < 0.0f ? this->negativeColour : this->positiveColour};
+    colour.a = chanValue < 0.0f ? (chanValue / this->minChannelValue) : (chanValue / this->maxChannelValue);
+    return colour;
+  }
+
+  void drawChanSquare(const rack::widget::Widget::DrawArgs& args, const rack::math::Vec pos, const NVGcolor colour,
+                      const NVGcolor outlineColour) {
     nvgFillColor(args.vg, colour);
 
     nvgBeginPath(args.vg);
     nvgRect(args.vg, pos.x, pos.y, 2.0f, 2.0f);
     nvgFill(args.vg);
+
+    if (outlineColour.a > 0.0f) {
+      nvgStrokeColor(args.vg, outlineColour);
+      nvgStrokeWidth(args.vg, 0.5f);
+      nvgBeginPath(args.vg);
+      nvgRect(args.vg, pos.x + 0.25f, pos.y + 0.25f, 1.5f, 1.5f);
+      nvgStroke(args.vg);
+    }
   }
 };
 }  // namespace DANT
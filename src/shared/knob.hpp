@@ -1,7 +1,9 @@
 #pragma once
 
 #include "../plugin.hpp"
+#include "assets.hpp"
 #include "colours.hpp"
+#include "snapshot.hpp"
 
 namespace DANT {
 static const float CIRCLE_ORIGIN_TRANSFORM{-90.0f};  // NVG uses radians, 0 rads is 3 o'clock
@@ -10,9 +12,8 @@ static const float KNOB_NOTCH_WIDTH{1.5f};
 static const float KNOB_ARC_WIDTH{2.5f};
 
 static NVGpaint knobTexture(const rack::widget::Widget::DrawArgs& args, const float width, const float height) {
-  std::shared_ptr<rack::window::Image> metalGradTex =
-      APP->window->loadImage(rack::asset::plugin(pluginInstance, "res/metal-grad.png"));
-  return nvgImagePattern(args.vg, 0.0f, 0.0f, width, height, 0.0f, metalGradTex->handle, 1.0f);
+  const int image{APP->window->loadImage(DANT::Assets::get().metalGrad)->handle};
+  return nvgImagePattern(args.vg, 0.0f, 0.0f, width, height, 0.0f, image, 1.0f);
 }
 
 enum KnobViz {
@@ -30,6 +31,8 @@ struct Knob : rack::componentlibrary::RoundKnob {
   float cvScaler{1.0f};         // multiplier for the raw CV value
   int cvAttId{-1};              // optional param ID for CV input attenuverter
 
+  const DANT::Snapshot<DANT::CvState>* cvSnapshot{nullptr};  // published by the module, source of CV values
+
   struct ArcData {
     float knobWidth;       // for knob BG image
     float knobHeight;      // for knob BG image
@@ -47,8 +50,8 @@ struct Knob : rack::componentlibrary::RoundKnob {
   ArcData arcData;
 
   Knob() {
-    this->setSvg(APP->window->loadSvg(rack::asset::plugin(pluginInstance, "res/knob-fg.svg")));
-    this->bg->setSvg(APP->window->loadSvg(rack::asset::plugin(pluginInstance, "res/knob-bg.svg")));
+    this->setSvg(APP->window->loadSvg(DANT::Assets::get().knobFg));
+    this->bg->setSvg(APP->window->loadSvg(DANT::Assets::get().knobBg));
     this->shadow->opacity = 0.0f;
     this->minAngle = -this->angle * DANT::PI;
     this->maxAngle = this->angle * DANT::PI;
@@ -75,8 +78,8 @@ struct Knob : rack::componentlibrary::RoundKnob {
   }
 
   float getCvValue(const bool bip = false) {
-    if (this->inputId > -1 && this->module) {
-      float v{this->module->inputs[this->inputId].getNormalVoltage(0.0f)};
+    if (this->inputId > -1 && this->cvSnapshot) {
+      float v{this->cvSnapshot->read().voltages[this->inputId]};
       float minCv{bip ? -10.0f : 0.0f};
       float maxCv{10.0f};
       return rack::math::rescale(v, minCv * this->cvScaler, maxCv * this->cvScaler, 0.0f, 1.0f);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <rack.hpp>
 
 namespace DANT {
@@ -19,6 +20,8 @@ struct FloatValueQuantity : rack::Quantity {
   float maxValue;
   float defaultValue;
   float* srcRange;
+  std::function<float()> getter;  // used instead of srcRange when set, for values that can't be written in place
+  std::function<void(float)> setter;
   std::string unit;
   float displayMultiplier;
   std::string formatStr;
@@ -35,8 +38,23 @@ struct FloatValueQuantity : rack::Quantity {
     formatStr = _formatStr;
   }
 
-  void setValue(float value) override { *srcRange = rack::math::clamp(value, getMinValue(), getMaxValue()); }
-  float getValue() override { return *srcRange; }
+  FloatValueQuantity(const std::string& _name, float _min, float _max, float _default, std::function<float()> _getter,
+                     std::function<void(float)> _setter, const std::string& _unit = "", float _displayMult = 1.0f,
+                     const std::string& _formatStr = "%.2f")
+      : FloatValueQuantity(_name, _min, _max, _default, nullptr, _unit, _displayMult, _formatStr) {
+    getter = _getter;
+    setter = _setter;
+  }
+
+  void setValue(float value) override {
+    const float clamped{rack::math::clamp(value, getMinValue(), getMaxValue())};
+    if (setter) {
+      setter(clamped);
+    } else {
+      *srcRange = clamped;
+    }
+  }
+  float getValue() override { return getter ? getter() : *srcRange; }
   float getMinValue() override { return minValue; }
   float getMaxValue() override { return maxValue; }
   float getDefaultValue() override { return defaultValue; }
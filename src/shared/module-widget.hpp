@@ -4,8 +4,10 @@
 #include <string>
 
 #include "../plugin.hpp"
+#include "capture-menu.hpp"
 #include "menu-slider.hpp"
 #include "panel.hpp"
+#include "performance-menu.hpp"
 
 namespace DANT {
 static const float RGB_SLIDER_WIDTH{200.0f};
@@ -13,8 +15,12 @@ static const float RGB_SLIDER_WIDTH{200.0f};
 struct ModuleWidget : rack::app::ModuleWidget {
   virtual std::string moduleName() { return ""; }
 
+  // text and symbols drawn on top of the panel, modules override this
+  virtual void drawPanelLabels(const rack::widget::Widget::DrawArgs& args) {}
+
   void draw(const rack::widget::Widget::DrawArgs& args) override {
     DANT::drawPanel(args, this);
+    drawPanelLabels(args);
 
     rack::app::ModuleWidget::draw(args);
   }
@@ -34,7 +40,25 @@ struct ModuleWidget : rack::app::ModuleWidget {
       menu->addChild(new DANT::MenuSlider(new DANT::RGBValueQuantity(RGB_R, &DANT::PANEL_R_D), DANT::RGB_SLIDER_WIDTH));
       menu->addChild(new DANT::MenuSlider(new DANT::RGBValueQuantity(RGB_G, &DANT::PANEL_G_D), DANT::RGB_SLIDER_WIDTH));
       menu->addChild(new DANT::MenuSlider(new DANT::RGBValueQuantity(RGB_B, &DANT::PANEL_B_D), DANT::RGB_SLIDER_WIDTH));
+      menu->addChild(new rack::ui::MenuSeparator);
+      menu->addChild(rack::createBoolMenuItem(
+          "Eco mode", "", [=]() { return DANT::ECO_MODE.load(); },
+          [=](bool enabled) {
+            // every DanT module, saved straight away with the panel colours
+            DANT::ECO_MODE.store(enabled);
+            DANT::saveUserSettings();
+          }));
     }));
+    DANT::Captured* captured = dynamic_cast<DANT::Captured*>(this->module);
+    if (captured && rack::settings::devMode) {
+      DANT::appendCaptureMenu(menu, &captured->capture, this->module, this->model->slug, captured->captureBlocked());
+    }
+#if defined(DANT_PERF_TIMING)
+    DANT::ProcessTimed* timed = dynamic_cast<DANT::ProcessTimed*>(this->module);
+    if (timed) {
+      DANT::appendPerformanceMenu(menu, &timed->processTiming);
+    }
+#endif
   }
 };
 }  // namespace DANT
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <functional>
+#include <rack.hpp>
+
+#include "../dsp/mono-block.hpp"
+
+namespace DANT {
+
+/**
+ * Context menu item for a module's mono block mode, read and set through the module's own setting.
+ */
+inline void appendMonoBlockMenu(rack::ui::Menu* menu, std::function<bool()> isEnabled,
+                                std::function<void(bool)> setEnabled) {
+  const float latencyMs{1000.0f * static_cast<float>(DANT::MONO_BLOCK_FRAMES) / APP->engine->getSampleRate()};
+  menu->addChild(rack::createBoolMenuItem(
+      "Mono Block Mode", rack::string::f("%d samples, %.2f ms latency", DANT::MONO_BLOCK_FRAMES, latencyMs),
+      isEnabled, setEnabled));
+}
+
+}  // namespace DANT
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <rack.hpp>
+
+#include "../dsp/process-timing.hpp"
+
+namespace DANT {
+
+/**
+ * Context menu with the process() timings of a module, a snapshot taken when the submenu opens.
+ */
+inline void appendPerformanceMenu(rack::ui::Menu* menu, DANT::ProcessTiming* timing) {
+  menu->addChild(rack::createSubmenuItem("Performance", "", [=](rack::ui::Menu* menu) {
+    const DANT::TimingStats stats{timing->read()};
+    const double sampleNs{1.0e9 / APP->engine->getSampleRate()};
+    menu->addChild(rack::createMenuLabel(rack::string::f("Calls: %llu", static_cast<unsigned long long>(stats.calls))));
+    menu->addChild(rack::createMenuLabel(rack::string::f("p50: %.0f ns", stats.p50Ns)));
+    menu->addChild(rack::createMenuLabel(rack::string::f("p99: %.0f ns", stats.p99Ns)));
+    menu->addChild(rack::createMenuLabel(rack::string::f("max: %.0f ns", stats.maxNs)));
+    menu->addChild(rack::createMenuLabel(rack::string::f("Sample period: %.0f ns", sampleNs)));
+    menu->addChild(rack::createMenuItem("Reset", "", [=]() { timing->requestReset(); }));
+  }));
+}
+
+}  // namespace DANT
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../plugin.hpp"
+#include "assets.hpp"
 #include "colours.hpp"
 
 namespace DANT {
@@ -11,7 +12,7 @@ struct Port : rack::app::SvgPort {
   bool isOutput{false};
 
   Port() {
-    this->setSvg(APP->window->loadSvg(rack::asset::plugin(pluginInstance, "res/port.svg")));
+    this->setSvg(APP->window->loadSvg(DANT::Assets::get().port));
     this->shadow->opacity = 0.0f;
   }
 
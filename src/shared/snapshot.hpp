@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "../dsp/cache-line.hpp"
+#include "../static.hpp"
+
+namespace DANT {
+
+static const uint32_t SNAPSHOT_DIVISION{256};  // samples between display state publications, ~190Hz at 48kHz
+static const uint32_t ECO_SNAPSHOT_DIVISION{1024};  // in Eco mode, ~47Hz at 48kHz
+
+/**
+ * Single-writer sequence lock, publishes display state from the audio thread to the UI thread.
+ * The writer never waits, a reader that overlaps a publication retries, so reads are never torn.
+ * Each snapshot has cache lines of its own, so a polling reader never contends with the writer's per sample state.
+ */
+template <typename T>
+struct alignas(DANT::CACHE_LINE) Snapshot {
+  void publish(const T& value) {
+    const uint32_t seq{this->sequence.load(std::memory_order_relaxed)};
+    this->sequence.store(seq + 1u, std::memory_order_relaxed);  // odd, write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    this->data = value;
+    this->sequence.store(seq + 2u, std::memory_order_release);  // even, write complete
+  }
+
+  T read() const {
+    T value;
+    uint32_t before;
+    uint32_t after;
+    do {
+      before = this->sequence.load(std::memory_order_acquire);
+      value = this->data;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = this->sequence.load(std::memory_order_relaxed);
+    } while ((before & 1u) != 0u || before != after);
+    return value;
+  }
+
+ private:
+  std::atomic<uint32_t> sequence{0u};
+  T data{};
+};
+
+/**
+ * Channel count and per channel levels shown by a GridLight, reduced by a PolyMeter.
+ */
+struct GridLightState {
+  int numChannels{0};
+  rack::simd::float_4 peak[DANT::SIMD]{};
+  rack::simd::float_4 rms[DANT::SIMD]{};
+};
+
+/**
+ * First channel voltage of each module input, used by knob CV visualisations.
+ */
+struct CvState {
+  float voltages[DANT::CHANS]{};
+};
+
+static_assert(alignof(Snapshot<GridLightState>) == CACHE_LINE && sizeof(Snapshot<GridLightState>) % CACHE_LINE == 0,
+              "a grid light snapshot must fill whole cache lines");
+static_assert(alignof(Snapshot<CvState>) == CACHE_LINE && sizeof(Snapshot<CvState>) % CACHE_LINE == 0,
+              "a CV snapshot must fill whole cache lines");
+
+}  // namespace DANT
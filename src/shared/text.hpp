@@ -4,18 +4,14 @@
 #include <vector>
 
 #include "../plugin.hpp"
+#include "assets.hpp"
 #include "colours.hpp"
 
 namespace DANT {
 
-static const std::string REGULAR_TTF{"fonts/CourierPrime-Regular.ttf"};
-static const std::string BOLD_TTF{"fonts/CourierPrime-Bold.ttf"};
-static const std::string SYMBOLS_TTF{"fonts/MaterialSymbolsSharp[FILL,GRAD,opsz,wght].ttf"};
-
 struct Fonts {
   static void prepareFont(const rack::widget::Widget::DrawArgs& args, const std::string ttfFile) {
-    std::shared_ptr<rack::window::Font> fontTTF =
-        APP->window->loadFont(rack::asset::plugin(pluginInstance, ttfFile.c_str()));
+    std::shared_ptr<rack::window::Font> fontTTF = APP->window->loadFont(DANT::Assets::get().font(ttfFile));
 
     if (!fontTTF) {
       DEBUG("TTF [%s] failed to load", ttfFile.c_str());
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "../dsp/cache-line.hpp"
+
+namespace DANT {
+
+/**
+ * Lock-free triple buffer, publishes settings from the UI thread to the audio thread.
+ * The writer fills its back buffer and swaps it with the middle one, the reader swaps the middle buffer with its
+ * front one when a new value is waiting. Neither side ever waits and the reader never sees a partly written value,
+ * a value written several times before the reader updates is only seen in its latest state.
+ * One writer: the UI thread, or any thread while the engine isn't running the module, e.g. dataFromJson.
+ */
+template <typename T>
+struct TripleBuffer {
+  // writer: publishes a value, picked up by the reader's next update()
+  void write(const T& value) {
+    this->latestValue = value;
+    this->slots[this->back].value = value;
+    this->back = this->middle.exchange(static_cast<uint8_t>(this->back | NEW_BIT), std::memory_order_acq_rel) &
+                 INDEX_MASK;
+  }
+
+  // writer: the last value written, for menus and saving
+  const T& latest() const { return this->latestValue; }
+
+  // reader: takes the newest value if one was written since the last update, returns true if it did
+  bool update() {
+    if ((this->middle.load(std::memory_order_relaxed) & NEW_BIT) == 0u) {
+      return false;
+    }
+    this->front = this->middle.exchange(this->front, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+  }
+
+  // reader: the value taken by the last update
+  const T& read() const { return this->slots[this->front].value; }
+
+ private:
+  static const uint8_t INDEX_MASK{0x3u};
+  static const uint8_t NEW_BIT{0x4u};
+
+  struct alignas(DANT::CACHE_LINE) Slot {
+    T value{};
+  };
+
+  Slot slots[3];
+  // writer state
+  alignas(DANT::CACHE_LINE) T latestValue{};
+  uint8_t back{2u};
+  // shared, the middle buffer's index and whether it holds a value the reader hasn't taken
+  alignas(DANT::CACHE_LINE) std::atomic<uint8_t> middle{1u};
+  // reader state
+  alignas(DANT::CACHE_LINE) uint8_t front{0u};
+};
+
+}  // namespace DANT
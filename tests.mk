@@ -11,6 +11,10 @@ TEST_CXXFLAGS = -std=c++11 -Wall -Wextra -g -Wno-unused-parameter $(ARCH_FLAG)
 ifeq ($(ARCH_OS), mac)
 	TEST_INCLUDE_DIRS = -Isrc/dsp -I$(CATCH2_DIR) -I$(RACK_DIR) -I$(RACK_DIR)/include -I$(RACK_DIR)/dep/include
 	TEST_LDFLAGS += -L$(RACK_DIR) -lRack -Wl,-rpath,$(RACK_DIR) $(ARCH_FLAG)
+else ifeq ($(ARCH_OS), lin)
+	TEST_INCLUDE_DIRS = -Isrc/dsp -I$(CATCH2_DIR) -I$(RACK_DIR) -I$(RACK_DIR)/include -I$(RACK_DIR)/dep/include
+	# libdl for the real-time audit's interposed functions, see tests/rt-audit.cpp
+	TEST_LDFLAGS += -L$(RACK_DIR) -lRack -Wl,-rpath,$(RACK_DIR) -ldl -lpthread
 else
 	TEST_INCLUDE_DIRS = -L/mingw64/lib -Isrc/dsp -I$(CATCH2_DIR) -I$(RACK_DIR) -I$(RACK_DIR)/include -I$(RACK_DIR)/dep/include
 	TEST_LDFLAGS += -L$(RACK_DIR) -lRack -lnanovg
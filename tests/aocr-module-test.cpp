@@ -0,0 +1,277 @@
+#include "../src/modules/aocr.cpp"
+
+#include <cstdio>
+#include <memory>
+#include <rack.hpp>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "mapped-file.hpp"
+#include "module-harness.hpp"
+
+const float FP_TOLERANCE_AOCR = 1e-6f;
+
+TEST_CASE("aocr.cpp::AocrModule") {
+  for (const int numChannels : {1, 3, 4, 8, 13, 16}) {
+    SECTION("Default settings pass the signal through, " + std::to_string(numChannels) + " channels") {
+      DANT::ModuleHarness<AocrModule> harness;
+      harness.connectInput(AocrModule::SGNL_INPUT, numChannels, DANT::Cv::perChannel(-3.0f, 0.5f));
+      harness.run(2);
+
+      REQUIRE(harness.getOutputChannels(AocrModule::SGNL_OUTPUT) == numChannels);
+      for (int c{0}; c < numChannels; ++c) {
+        UNSCOPED_INFO("channel [" << c << "]");
+        CHECK(harness.getOutput(AocrModule::SGNL_OUTPUT, c) ==
+              Catch::Detail::Approx(-3.0f + (0.5f * c)).epsilon(FP_TOLERANCE_AOCR));
+      }
+    }
+  }
+
+  SECTION("Parameters are applied in the selected order, mono and poly paths agree") {
+    const float inputs[4]{-12.0f, -2.0f, 2.0f, 12.0f};
+    const float expected[4]{-2.5f, -2.5f, -3.5f, -5.0f};  // CROA, a = -0.5, o = 5, ±5v clip, half rectify
+
+    DANT::ModuleHarness<AocrModule> mono;
+    DANT::ModuleHarness<AocrModule> poly;
+    for (DANT::ModuleHarness<AocrModule>* harness : {&mono, &poly}) {
+      harness->setParam(AocrModule::ORDER_PARAM, DANT::OP_ORDER::CROA);
+      harness->setParam(AocrModule::ATV_PARAM, -0.5f);
+      harness->setParam(AocrModule::OFS_PARAM, 5.0f);
+      harness->setParam(AocrModule::CLIP_PARAM, DANT::CLIP_LVL::FIVE_CLIP);
+      harness->setParam(AocrModule::RECT_PARAM, DANT::RECT_LVL::HALF_RECT);
+    }
+    poly.connectInput(AocrModule::SGNL_INPUT, 4,
+                      [&](const double seconds, const int channel) { return inputs[channel]; });
+    poly.step();
+
+    for (int c{0}; c < 4; ++c) {
+      mono.connectInput(AocrModule::SGNL_INPUT, 1, DANT::Cv::constant(inputs[c]));
+      mono.step();
+
+      UNSCOPED_INFO("input [" << inputs[c] << "]");
+      CHECK(mono.getOutput(AocrModule::SGNL_OUTPUT) == Catch::Detail::Approx(expected[c]).epsilon(FP_TOLERANCE_AOCR));
+      CHECK(poly.getOutput(AocrModule::SGNL_OUTPUT, c) ==
+            Catch::Detail::Approx(expected[c]).epsilon(FP_TOLERANCE_AOCR));
+    }
+  }
+
+  SECTION("CV inputs are attenuverted and added to the knobs") {
+    DANT::ModuleHarness<AocrModule> harness;
+    harness.setParam(AocrModule::ATV_PARAM, 0.0f);
+    harness.setParam(AocrModule::ATV_CV_ATV_PARAM, 0.5f);
+    harness.setParam(AocrModule::OFS_CV_ATV_PARAM, -1.0f);
+    harness.connectInput(AocrModule::SGNL_INPUT, 1, DANT::Cv::constant(4.0f));
+    harness.connectInput(AocrModule::ATV_CV_INPUT, 1, DANT::Cv::constant(3.0f));
+    harness.connectInput(AocrModule::OFS_CV_INPUT, 1, DANT::Cv::constant(1.0f));
+    harness.step();
+
+    CHECK(harness.getOutput(AocrModule::SGNL_OUTPUT) == Catch::Detail::Approx(5.0f).epsilon(FP_TOLERANCE_AOCR));
+  }
+
+  SECTION("Modules placed side by side chain their signal without a cable") {
+    DANT::ModuleHarness<AocrModule> left;
+    DANT::ModuleHarness<AocrModule> right;
+    left.setParam(AocrModule::OFS_PARAM, 1.0f);
+    right.setParam(AocrModule::ATV_PARAM, 2.0f);
+    left.connectInput(AocrModule::SGNL_INPUT, 5, DANT::Cv::perChannel(-2.0f, 1.0f));
+    left.placeLeftOf(right);
+    for (int frame{0}; frame < 2; ++frame) {
+      left.step();
+      right.step();
+    }
+    // off by default, so modules placed side by side in an existing patch sound the same
+    CHECK(right.getOutputChannels(AocrModule::SGNL_OUTPUT) == 1);
+    CHECK(right.getOutput(AocrModule::SGNL_OUTPUT) == 0.0f);
+
+    right.module.chain.setEnabled(true);
+    for (int frame{0}; frame < 2; ++frame) {
+      left.step();
+      right.step();
+    }
+    REQUIRE(right.getOutputChannels(AocrModule::SGNL_OUTPUT) == 5);
+    for (int c{0}; c < 5; ++c) {
+      UNSCOPED_INFO("channel [" << c << "]");
+      CHECK(right.getOutput(AocrModule::SGNL_OUTPUT, c) ==
+            Catch::Detail::Approx(2.0f * (-1.0f + c)).epsilon(FP_TOLERANCE_AOCR));
+    }
+
+    right.module.onReset();
+    CHECK_FALSE(right.module.chain.isEnabled());
+  }
+
+  SECTION("Eco mode reads the CVs at control rate") {
+    DANT::ScopedEcoMode eco;
+    DANT::ModuleHarness<AocrModule> harness;
+    harness.setParam(AocrModule::OFS_PARAM, 0.0f);
+    harness.connectInput(AocrModule::SGNL_INPUT, 1, DANT::Cv::constant(1.0f));
+    harness.connectInput(AocrModule::OFS_CV_INPUT, 1, DANT::Cv::constant(1.0f));
+    harness.step();
+    CHECK(harness.getOutput(AocrModule::SGNL_OUTPUT) == Catch::Detail::Approx(2.0f).epsilon(FP_TOLERANCE_AOCR));
+
+    // a CV change is picked up at the next control rate read
+    harness.connectInput(AocrModule::OFS_CV_INPUT, 1, DANT::Cv::constant(3.0f));
+    harness.setRealtimeAudit(true);
+    for (uint32_t i{1u}; i < DANT::ECO_CV_DIVISION; ++i) {
+      harness.step();
+      CHECK(harness.getOutput(AocrModule::SGNL_OUTPUT) == Catch::Detail::Approx(2.0f).epsilon(FP_TOLERANCE_AOCR));
+    }
+    harness.step();
+    CHECK(harness.getOutput(AocrModule::SGNL_OUTPUT) == Catch::Detail::Approx(4.0f).epsilon(FP_TOLERANCE_AOCR));
+    CHECK(harness.module.snapshotDivider.getDivision() == DANT::ECO_SNAPSHOT_DIVISION);
+    CHECK(harness.getRealtimeViolations() == 0u);
+  }
+
+  SECTION("Eco mode meters the grid lights at control rate, at the same scale") {
+    DANT::ScopedEcoMode eco;
+    for (const int numChannels : {1, 4}) {
+      DANT::ModuleHarness<AocrModule> harness;
+      harness.setParam(AocrModule::ATV_PARAM, 2.0f);
+      harness.connectInput(AocrModule::SGNL_INPUT, numChannels, DANT::Cv::constant(1.5f));
+      harness.run(static_cast<int>(DANT::ECO_SNAPSHOT_DIVISION) * 2);
+      UNSCOPED_INFO("channels [" << numChannels << "]");
+      CHECK(harness.module.inputGridSnapshot.read().rms[0][0] == Catch::Detail::Approx(1.5f));
+      CHECK(harness.module.outputGridSnapshot.read().rms[0][0] == Catch::Detail::Approx(3.0f));
+      CHECK(harness.module.outputGridSnapshot.read().peak[0][0] == Catch::Detail::Approx(3.0f));
+    }
+  }
+
+  SECTION("Mono block mode delays the output by the block length") {
+    const int frames{DANT::MONO_BLOCK_FRAMES};
+    DANT::ModuleHarness<AocrModule> direct;
+    DANT::ModuleHarness<AocrModule> blocked;
+    blocked.module.monoBlockMode = true;
+    for (DANT::ModuleHarness<AocrModule>* harness : {&direct, &blocked}) {
+      harness->setParam(AocrModule::ATV_PARAM, 1.5f);
+      harness->setParam(AocrModule::CLIP_PARAM, DANT::CLIP_LVL::FIVE_CLIP);
+      harness->connectInput(AocrModule::SGNL_INPUT, 1, DANT::Cv::sine(440.0f, 5.0f));
+    }
+
+    const int numFrames{256};
+    std::vector<float> directOut{direct.collect(AocrModule::SGNL_OUTPUT, 0, numFrames)};
+    std::vector<float> blockedOut{blocked.collect(AocrModule::SGNL_OUTPUT, 0, numFrames)};
+
+    for (int i{0}; i < numFrames; ++i) {
+      const float expected{i < frames ? 0.0f : directOut[i - frames]};
+      UNSCOPED_INFO("frame [" << i << "]");
+      CHECK(blockedOut[i] == Catch::Detail::Approx(expected).epsilon(FP_TOLERANCE_AOCR).margin(1e-6));
+    }
+  }
+}
+
+TEST_CASE("aocr.cpp::AocrModule real-time safety") {
+  REQUIRE(DANT::RtAudit::isInterposed());
+
+  for (const int numChannels : {1, 4, 8, 16}) {
+    for (const int frames : {0, 4}) {
+      if (frames > 0 && numChannels > 1) {
+        continue;  // mono block mode only applies to mono signals
+      }
+      SECTION("process() never allocates, locks or does file I/O, " + std::to_string(numChannels) + " channels, " +
+              std::to_string(frames) + " block frames") {
+        DANT::ModuleHarness<AocrModule> harness;
+        harness.module.monoBlockMode = frames > 0;
+        harness.connectInput(AocrModule::SGNL_INPUT, numChannels, DANT::Cv::sine(440.0f, 12.0f));
+        harness.connectInput(AocrModule::ATV_CV_INPUT, numChannels, DANT::Cv::sine(3.0f, 5.0f));
+        harness.connectInput(AocrModule::OFS_CV_INPUT, numChannels, DANT::Cv::sine(7.0f, 5.0f));
+
+        for (int order{0}; order < DANT::NUM_OP_ORDERS; ++order) {
+          for (const DANT::CLIP_LVL clip : {DANT::NO_CLIP, DANT::TEN_CLIP, DANT::FIVE_CLIP}) {
+            for (const DANT::RECT_LVL rect : {DANT::NO_RECT, DANT::HALF_RECT, DANT::FULL_RECT}) {
+              for (const DANT::RECT_TYPE rectType : {DANT::POS_RECT, DANT::NEG_RECT}) {
+                harness.setParam(AocrModule::ORDER_PARAM, static_cast<float>(order));
+                harness.setParam(AocrModule::CLIP_PARAM, clip);
+                harness.setParam(AocrModule::RECT_PARAM, rect);
+                harness.setParam(AocrModule::RTYPE_PARAM, rectType);
+                harness.setRealtimeAudit(true);
+                harness.run(DANT::SNAPSHOT_DIVISION + 1);  // includes a snapshot publication
+                harness.setRealtimeAudit(false);
+
+                UNSCOPED_INFO("order " << DANT::OP_ORDER_NAMES[order] << ", clip " << clip << ", rect " << rect
+                                       << ", type " << rectType << ": " << harness.describeRealtimeViolations());
+                CHECK(harness.getRealtimeViolations() == 0u);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("aocr.cpp::AocrModule capture and replay") {
+  const std::string path{"aocr-capture-test.dantcap"};
+  const int numFrames{2000};
+
+  DANT::ModuleHarness<AocrModule> live;
+  live.setParam(AocrModule::ORDER_PARAM, DANT::OP_ORDER::OCRA);
+  live.setParam(AocrModule::CLIP_PARAM, DANT::CLIP_LVL::FIVE_CLIP);
+  live.connectInput(AocrModule::SGNL_INPUT, 3, DANT::Cv::sine(220.0f, 8.0f));
+  live.connectInput(AocrModule::OFS_CV_INPUT, 1, DANT::Cv::gate(0.01, 0.01));
+  REQUIRE(live.module.capture.start(path, "AOCR", live.getSampleRate(), live.module));
+  std::vector<float> liveOut{live.collect(AocrModule::SGNL_OUTPUT, 2, numFrames)};
+  live.module.capture.stop();
+
+  SECTION("Replay reproduces the live output") {
+    DANT::MappedFile file(path);
+    REQUIRE(file.isOpen());
+    DANT::CaptureDecoder decoder;
+    REQUIRE(decoder.open(file.data(), file.size()));
+
+    DANT::ModuleHarness<AocrModule> replayed;
+    for (int i{0}; i < numFrames; ++i) {
+      REQUIRE(replayed.replay(decoder, 1) == 1);
+      UNSCOPED_INFO("frame [" << i << "]");
+      CHECK(replayed.getOutput(AocrModule::SGNL_OUTPUT, 2) == liveOut[i]);
+    }
+    CHECK(replayed.replay(decoder) == 0);
+  }
+  std::remove(path.c_str());
+}
+
+TEST_CASE("aocr.cpp::AocrModule capture of a chained signal") {
+  const std::string path{"aocr-chain-capture-test.dantcap"};
+  const int numFrames{500};
+
+  DANT::ModuleHarness<AocrModule> left;
+  DANT::ModuleHarness<AocrModule> live;
+  left.connectInput(AocrModule::SGNL_INPUT, 2, DANT::Cv::sine(220.0f, 4.0f));
+  live.setParam(AocrModule::ATV_PARAM, 0.5f);
+  live.module.chain.setEnabled(true);
+  left.placeLeftOf(live);
+  REQUIRE(live.module.capture.start(path, "AOCR", live.getSampleRate(), live.module));
+  std::vector<float> liveOut;
+  for (int i{0}; i < numFrames; ++i) {
+    left.step();
+    live.step();
+    liveOut.push_back(live.getOutput(AocrModule::SGNL_OUTPUT, 1));
+  }
+  live.module.capture.stop();
+
+  // the chained signal is captured in place of the unpatched input, so a module on its own replays it
+  DANT::MappedFile file(path);
+  REQUIRE(file.isOpen());
+  DANT::CaptureDecoder decoder;
+  REQUIRE(decoder.open(file.data(), file.size()));
+  DANT::ModuleHarness<AocrModule> replayed;
+  for (int i{0}; i < numFrames; ++i) {
+    REQUIRE(replayed.replay(decoder, 1) == 1);
+    UNSCOPED_INFO("frame [" << i << "]");
+    CHECK(replayed.getOutput(AocrModule::SGNL_OUTPUT, 1) == liveOut[i]);
+  }
+  std::remove(path.c_str());
+}
+
+TEST_CASE("aocr.cpp::AocrModule layout") {
+  std::unique_ptr<DANT::ModuleHarness<AocrModule>> harness{new DANT::ModuleHarness<AocrModule>()};
+  AocrModule& module = harness->module;
+
+  // state the UI thread reads never shares a cache line with state the audio thread writes every sample
+  CHECK(DANT::isCacheAligned(&module));
+  CHECK(DANT::isCacheAligned(&module.inputGridSnapshot));
+  CHECK(DANT::isCacheAligned(&module.outputGridSnapshot));
+  CHECK(DANT::isCacheAligned(&module.cvSnapshot));
+  CHECK(DANT::isCacheAligned(&module.eco));
+  CHECK(reinterpret_cast<const char*>(&module.eco) >=
+        reinterpret_cast<const char*>(&module.cvSnapshot) + sizeof(module.cvSnapshot));
+}
@@ -196,6 +196,37 @@ TEST_CASE("att-off-clip-rect.hpp::attenuvertOffsetClipRectify") {
       rack::simd::float_4 outSignals = DANT::attenuvertOffsetClipRectify(testCase.inSignals, testCase.opts);
 
       check_float4_approx_equal(testCase.inSignals, outSignals, testCase.expectedSignals);
+
+      // the scalar mono path matches each lane
+      for (int i{0}; i < 4; ++i) {
+        float outSignal = DANT::attenuvertOffsetClipRectify(testCase.inSignals[i], testCase.opts);
+
+        UNSCOPED_INFO("scalar input [" << testCase.inSignals[i] << "]");
+        CHECK(outSignal == Catch::Detail::Approx(testCase.expectedSignals[i]).epsilon(FP_TOLERANCE));
+      }
+    }
+  }
+}
+
+TEST_CASE("att-off-clip-rect.hpp::opStep") {
+  const std::string ops{"AOCR"};
+  for (int order{0}; order < DANT::NUM_OP_ORDERS; ++order) {
+    SECTION(DANT::OP_ORDER_NAMES[order]) {
+      int stepsUsed[4]{0, 0, 0, 0};
+      for (const char op : ops) {
+        int step{DANT::opStep(DANT::toOpOrder(order), op)};
+        UNSCOPED_INFO("op [" << op << "]");
+        REQUIRE(step >= 0);
+        CHECK(DANT::OP_ORDER_NAMES[order][step] == op);
+        ++stepsUsed[step];
+      }
+      CHECK((stepsUsed[0] == 1 && stepsUsed[1] == 1 && stepsUsed[2] == 1 && stepsUsed[3] == 1));
     }
   }
+
+  SECTION("Out of range orders fall back to AOCR") {
+    CHECK(DANT::toOpOrder(-1) == DANT::OP_ORDER::AOCR);
+    CHECK(DANT::toOpOrder(DANT::NUM_OP_ORDERS) == DANT::OP_ORDER::AOCR);
+    CHECK(DANT::opStep(DANT::OP_ORDER::AOCR, 'X') == -1);
+  }
 }
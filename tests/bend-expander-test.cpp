@@ -0,0 +1,116 @@
+#include "../src/modules/bend-expander.cpp"
+
+#include <memory>
+#include <rack.hpp>
+
+#include "catch2/catch.hpp"
+#include "module-harness.hpp"
+
+namespace {
+
+// the state a Bend on the left sends, lane 0 bending, 1 holding, 2 unbending and 3 ended
+DANT::BendPolyState sentState() {
+  DANT::BendPolyState state;
+  state.channels = 4;
+  state.progress[0] = rack::simd::float_4(0.25f, 1.0f, 0.5f, 0.0f);
+  state.envelope[0] = rack::simd::float_4(0.0625f, 1.0f, 0.75f, 0.0f);
+  state.bending.bits = 0x1u;
+  state.holding.bits = 0x2u;
+  state.unbending.bits = 0x4u;
+  state.ended.bits = 0x8u;
+  return state;
+}
+
+// a frame of the state, written and flipped like a Bend on the left does
+void send(rack::engine::Module& module, const DANT::BendPolyState& state) {
+  *static_cast<DANT::BendPolyState*>(module.leftExpander.producerMessage) = state;
+  module.leftExpander.requestMessageFlip();
+}
+
+}  // namespace
+
+TEST_CASE("bend-expander.cpp::BendExpanderModule") {
+  std::unique_ptr<DANT::ModuleHarness<BendExpanderModule>> harness{new DANT::ModuleHarness<BendExpanderModule>()};
+  BendExpanderModule& module = harness->module;
+
+  SECTION("Outputs each channel's state a frame after it was sent") {
+    send(module, sentState());
+    harness->step();
+    CHECK(harness->getOutputChannels(BendExpanderModule::PROGRESS_OUTPUT) == 1);
+    CHECK(harness->getOutput(BendExpanderModule::PROGRESS_OUTPUT) == 0.0f);
+    send(module, sentState());
+    harness->step();
+
+    for (int output{0}; output < BendExpanderModule::NUM_OUTPUTS; ++output) {
+      REQUIRE(harness->getOutputChannels(output) == 4);
+    }
+    CHECK(harness->getOutput(BendExpanderModule::PROGRESS_OUTPUT, 0) == 2.5f);
+    CHECK(harness->getOutput(BendExpanderModule::PROGRESS_OUTPUT, 1) == 10.0f);
+    CHECK(harness->getOutput(BendExpanderModule::ENVELOPE_OUTPUT, 0) == 0.625f);
+    CHECK(harness->getOutput(BendExpanderModule::ENVELOPE_OUTPUT, 2) == 7.5f);
+    const int gates[3]{BendExpanderModule::BENDING_OUTPUT, BendExpanderModule::HOLDING_OUTPUT,
+                       BendExpanderModule::UNBENDING_OUTPUT};
+    for (int g{0}; g < 3; ++g) {
+      for (int c{0}; c < 4; ++c) {
+        UNSCOPED_INFO("gate [" << g << "] channel [" << c << "]");
+        CHECK(harness->getOutput(gates[g], c) == (c == g ? 10.0f : 0.0f));
+      }
+    }
+    CHECK(harness->getOutput(BendExpanderModule::END_OUTPUT, 2) == 0.0f);
+    CHECK(harness->getOutput(BendExpanderModule::END_OUTPUT, 3) == 10.0f);
+  }
+
+  SECTION("End of bend triggers last 1ms") {
+    send(module, sentState());
+    harness->step();
+    DANT::BendPolyState idle;
+    idle.channels = 4;
+    send(module, idle);
+    harness->step();
+    const int triggerFrames{static_cast<int>(harness->getSampleRate() * 1e-3f)};
+    for (int frame{0}; frame < triggerFrames; ++frame) {
+      send(module, idle);
+      harness->step();
+      UNSCOPED_INFO("frame [" << frame << "]");
+      CHECK(harness->getOutput(BendExpanderModule::END_OUTPUT, 3) == (frame < triggerFrames - 1 ? 10.0f : 0.0f));
+    }
+  }
+
+  SECTION("End of bend triggers run out while their channels are missing") {
+    DANT::BendPolyState ended;
+    ended.channels = 8;
+    ended.ended.bits = 0x80u;
+    send(module, ended);
+    harness->step();
+    DANT::BendPolyState fewer;
+    fewer.channels = 4;
+    const int triggerFrames{static_cast<int>(harness->getSampleRate() * 1e-3f)};
+    for (int frame{0}; frame < triggerFrames + 1; ++frame) {
+      send(module, fewer);
+      harness->step();
+    }
+    DANT::BendPolyState idle;
+    idle.channels = 8;
+    send(module, idle);
+    harness->run(2);
+    REQUIRE(harness->getOutputChannels(BendExpanderModule::END_OUTPUT) == 8);
+    CHECK(harness->getOutput(BendExpanderModule::END_OUTPUT, 7) == 0.0f);
+  }
+
+  SECTION("A new module on the left clears the last state") {
+    send(module, sentState());
+    harness->run(2);
+    rack::engine::Module::ExpanderChangeEvent e;
+    e.side = 0;
+    module.onExpanderChange(e);
+    harness->step();
+    CHECK(harness->getOutputChannels(BendExpanderModule::PROGRESS_OUTPUT) == 1);
+    CHECK(harness->getOutput(BendExpanderModule::PROGRESS_OUTPUT) == 0.0f);
+  }
+}
+
+TEST_CASE("bend-expander.cpp::BendExpanderModule layout") {
+  std::unique_ptr<DANT::ModuleHarness<BendExpanderModule>> harness{new DANT::ModuleHarness<BendExpanderModule>()};
+  CHECK(DANT::isCacheAligned(&harness->module));
+  CHECK(DANT::isCacheAligned(&harness->module.endTimers));
+}
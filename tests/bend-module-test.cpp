@@ -0,0 +1,604 @@
+#include "../src/modules/bend.cpp"
+
+#include <cstdio>
+#include <memory>
+#include <rack.hpp>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "module-harness.hpp"
+
+const float FP_TOLERANCE_BEND = 1e-5f;
+const double BEND_START = 0.01;  // trigger inputs must be low before they can fire
+
+// one octave bend up, away from the input pitch, over 100ms, linear shape, triggered at BEND_START
+static void setup_timed_bend(DANT::ModuleHarness<BendModule>& harness, const int numChannels) {
+  harness.setParam(BendModule::LENGTH_PARAM, 0.1f);
+  harness.setParam(BendModule::BEND_ORIENTATION_PARAM, DANT::BEND_DIR::AWAY_FROM_PITCH);
+  harness.setParam(BendModule::BEND_DIR_PARAM, 1.0f);
+  harness.setParam(BendModule::BEND_AMOUNT_PARAM, 12.0f);
+  harness.setParam(BendModule::BEND_SHAPE_PARAM, 0.0f);
+  harness.connectInput(BendModule::SIGNALS_INPUT, numChannels, DANT::Cv::perChannel(0.0f, 0.25f));
+  harness.connectInput(BendModule::BEND_TRIG_INPUT, 1, DANT::Cv::gate(BEND_START, 0.001));
+}
+
+// runs until seconds after BEND_START and returns the bend offset of a channel
+static float offset_at(DANT::ModuleHarness<BendModule>& harness, const double seconds, const int channel = 0) {
+  while (harness.getSeconds() < BEND_START + seconds) {
+    harness.step();
+  }
+  return harness.getOutput(BendModule::SIGNALS_OUTPUT, channel) - (0.25f * channel);
+}
+
+// reads a Bend's state like a Bend Expander does
+struct StateReader : rack::engine::Module, DANT::BendStateReader {
+  StateReader() { attachBendState(*this); }
+};
+
+TEST_CASE("bend.cpp::BendModule") {
+  SECTION("Signals pass through until a bend is triggered") {
+    DANT::ModuleHarness<BendModule> harness;
+    harness.connectInput(BendModule::SIGNALS_INPUT, 6, DANT::Cv::perChannel(-1.0f, 0.5f));
+    harness.run(64);
+
+    REQUIRE(harness.getOutputChannels(BendModule::SIGNALS_OUTPUT) == 6);
+    for (int c{0}; c < 6; ++c) {
+      UNSCOPED_INFO("channel [" << c << "]");
+      CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT, c) ==
+            Catch::Detail::Approx(-1.0f + (0.5f * c)).epsilon(FP_TOLERANCE_BEND));
+    }
+  }
+
+  for (const float sampleRate : {44100.0f, 48000.0f, 96000.0f}) {
+    SECTION("Timed bend follows the linear shape and holds, " + std::to_string(static_cast<int>(sampleRate)) + "Hz") {
+      DANT::ModuleHarness<BendModule> harness(sampleRate);
+      setup_timed_bend(harness, 4);
+
+      CHECK(offset_at(harness, 0.05) == Catch::Detail::Approx(0.5f).margin(0.001));
+      for (int c{0}; c < 4; ++c) {
+        UNSCOPED_INFO("channel [" << c << "]");
+        CHECK(offset_at(harness, 0.2, c) == Catch::Detail::Approx(1.0f).margin(FP_TOLERANCE_BEND));
+      }
+    }
+  }
+
+  SECTION("Eco mode bends within a cent of the precise bend") {
+    const double times[4]{0.02, 0.05, 0.08, 0.2};
+    float expected[4]{};
+    DANT::ModuleHarness<BendModule> precise;
+    setup_timed_bend(precise, 4);
+    precise.setParam(BendModule::BEND_SHAPE_PARAM, 0.5f);
+    for (int i{0}; i < 4; ++i) {
+      expected[i] = offset_at(precise, times[i]);
+    }
+
+    DANT::ScopedEcoMode eco;
+    DANT::ModuleHarness<BendModule> cheap;
+    setup_timed_bend(cheap, 4);
+    cheap.connectInput(BendModule::BEND_SHAPE_CV_INPUT, 1, DANT::Cv::constant(0.5f));
+    cheap.setRealtimeAudit(true);
+    for (int i{0}; i < 4; ++i) {
+      UNSCOPED_INFO("seconds [" << times[i] << "]");
+      CHECK(offset_at(cheap, times[i]) == Catch::Detail::Approx(expected[i]).margin(1.0 / 1200.0));
+    }
+    CHECK(cheap.module.snapshotDivider.getDivision() == DANT::ECO_SNAPSHOT_DIVISION);
+    CHECK(cheap.getRealtimeViolations() == 0u);
+  }
+
+  SECTION("Eco mode reads resets and meters the bends at control rate") {
+    DANT::ScopedEcoMode eco;
+    DANT::ModuleHarness<BendModule> harness;
+    setup_timed_bend(harness, 4);
+    CHECK(offset_at(harness, 0.15) == Catch::Detail::Approx(1.0f).margin(0.001));
+    harness.run(static_cast<int>(DANT::ECO_SNAPSHOT_DIVISION) * 2);
+    CHECK(harness.module.gridSnapshot.read().rms[0][0] == Catch::Detail::Approx(1.0f).margin(0.001));
+    CHECK(harness.module.gridSnapshot.read().rms[0][3] == Catch::Detail::Approx(1.0f).margin(0.001));
+
+    // a reset as long as the control rate interval is never missed
+    harness.connectInput(BendModule::RESET_INPUT, 1, DANT::Cv::gate(harness.getSeconds(),
+                                                                   DANT::ECO_CV_DIVISION / harness.getSampleRate()));
+    harness.run(static_cast<int>(DANT::ECO_CV_DIVISION) + 1);
+    CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT) == Catch::Detail::Approx(0.0f).margin(FP_TOLERANCE_BEND));
+  }
+
+  SECTION("A trigger shorter than the light interval still lights the button") {
+    DANT::ScopedEcoMode eco;  // lights are set directly, without smoothing
+    DANT::ModuleHarness<BendModule> harness;
+    harness.connectInput(BendModule::SIGNALS_INPUT, 8, DANT::Cv::constant(0.0f));
+    harness.connectInput(BendModule::BEND_TRIG_INPUT, 8, DANT::Cv::constant(0.0f));
+    harness.connectInput(BendModule::RESET_INPUT, 1, DANT::Cv::constant(0.0f));
+    harness.run(static_cast<int>(LIGHT_DIVISION) + 3);
+    CHECK(harness.module.lights[BendModule::BEND_TRIG_LIGHT].getBrightness() == 0.0f);
+
+    // one sample on channel 5, between light updates
+    harness.connectInput(BendModule::BEND_TRIG_INPUT, 8,
+                         [](const double seconds, const int channel) { return channel == 5 ? 10.0f : 0.0f; });
+    harness.step();
+    harness.connectInput(BendModule::BEND_TRIG_INPUT, 8, DANT::Cv::constant(0.0f));
+    harness.run(static_cast<int>(LIGHT_DIVISION));
+    CHECK(harness.module.lights[BendModule::BEND_TRIG_LIGHT].getBrightness() == 1.0f);
+    CHECK(harness.module.lights[BendModule::RESET_LIGHT].getBrightness() == 0.0f);
+
+    harness.run(static_cast<int>(LIGHT_DIVISION));
+    CHECK(harness.module.lights[BendModule::BEND_TRIG_LIGHT].getBrightness() == 0.0f);
+  }
+
+  SECTION("Return completion ends the bend at the input pitch") {
+    DANT::ModuleHarness<BendModule> harness;
+    setup_timed_bend(harness, 1);
+    harness.setParam(BendModule::BEND_COMPLETION_PARAM, 0.0f);
+
+    CHECK(offset_at(harness, 0.05) == Catch::Detail::Approx(0.5f).margin(0.001));
+    CHECK(offset_at(harness, 0.2) == Catch::Detail::Approx(0.0f).margin(FP_TOLERANCE_BEND));
+  }
+
+  SECTION("Gate-Bends holds while the gate is high") {
+    DANT::ModuleHarness<BendModule> harness;
+    setup_timed_bend(harness, 1);
+    harness.module.setConfigValue(&BendModule::BendConfig::holdMethod, BendModule::GATE_BENDS);
+    harness.connectInput(BendModule::BEND_TRIG_INPUT, 1, DANT::Cv::gate(BEND_START, 0.3));
+
+    CHECK(offset_at(harness, 0.25) == Catch::Detail::Approx(1.0f).margin(FP_TOLERANCE_BEND));
+    CHECK(offset_at(harness, 0.35) == Catch::Detail::Approx(0.0f).margin(FP_TOLERANCE_BEND));
+  }
+
+  SECTION("Polyphonic triggers bend their own channel") {
+    DANT::ModuleHarness<BendModule> harness;
+    setup_timed_bend(harness, 2);
+    harness.connectInput(BendModule::BEND_TRIG_INPUT, 2, [](const double seconds, const int channel) {
+      return (channel == 1 && seconds >= BEND_START) ? 10.0f : 0.0f;
+    });
+
+    CHECK(offset_at(harness, 0.2, 0) == Catch::Detail::Approx(0.0f).margin(FP_TOLERANCE_BEND));
+    CHECK(offset_at(harness, 0.2, 1) == Catch::Detail::Approx(1.0f).margin(FP_TOLERANCE_BEND));
+  }
+
+  SECTION("Reset ends a held bend") {
+    DANT::ModuleHarness<BendModule> harness;
+    setup_timed_bend(harness, 1);
+    harness.connectInput(BendModule::RESET_INPUT, 1, DANT::Cv::gate(BEND_START + 0.15, 0.001));
+
+    CHECK(offset_at(harness, 0.12) == Catch::Detail::Approx(1.0f).margin(FP_TOLERANCE_BEND));
+    CHECK(offset_at(harness, 0.2) == Catch::Detail::Approx(0.0f).margin(FP_TOLERANCE_BEND));
+  }
+
+  SECTION("Settings reach the audio thread at the next sample and are saved") {
+    DANT::ModuleHarness<BendModule> harness;
+    harness.step();
+    harness.module.setConfigValue(&BendModule::BendConfig::unbendDurationPct, 0.5f);
+    harness.module.setConfigValue(&BendModule::BendConfig::holdMethod, BendModule::TOGGLE_TRIGGERS);
+    harness.module.setConfigValue(&BendModule::BendConfig::monoBlockMode, true);
+    harness.module.setConfigValue(&BendModule::BendConfig::snapToBeat, true);
+    CHECK(harness.module.config.unbendDurationPct == 0.10f);
+    CHECK_FALSE(harness.module.config.monoBlockMode);
+    harness.step();
+    CHECK(harness.module.config.unbendDurationPct == 0.5f);
+    CHECK(harness.module.config.holdMethod == BendModule::TOGGLE_TRIGGERS);
+    CHECK(harness.module.config.monoBlockMode);
+    CHECK(harness.module.unbendDurationScale[3] == 0.5f);
+
+    json_t* rootJ = harness.module.dataToJson();
+    DANT::ModuleHarness<BendModule> loaded;
+    loaded.module.dataFromJson(rootJ);
+    json_decref(rootJ);
+    CHECK(loaded.module.getConfig().unbendDurationPct == 0.5f);
+    CHECK(loaded.module.getConfig().holdMethod == BendModule::TOGGLE_TRIGGERS);
+    CHECK(loaded.module.getConfig().monoBlockMode);
+    CHECK(loaded.module.getConfig().snapToBeat);
+    loaded.step();
+    CHECK(loaded.module.config.holdMethod == BendModule::TOGGLE_TRIGGERS);
+  }
+
+  SECTION("Clocked bends follow the clock's period, from the first bend after loading a patch") {
+    DANT::ModuleHarness<BendModule> harness;
+    setup_timed_bend(harness, 1);
+    harness.setParam(BendModule::BEAT_DIV_PARAM, 0.0f);  // 1 beat
+    harness.connectInput(BendModule::EXT_CLOCK_INPUT, 1, DANT::Cv::pulses(0.002, 0.05));
+    harness.connectInput(BendModule::BEND_TRIG_INPUT, 1, DANT::Cv::gate(0.3, 0.001));
+    while (harness.getSeconds() < 0.3 + 0.025) {
+      harness.step();
+    }
+    CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT) == Catch::Detail::Approx(0.5f).margin(0.002));
+    CHECK(harness.module.clockFollower.period() == Catch::Detail::Approx(0.05f).margin(1e-5));
+
+    json_t* rootJ = harness.module.dataToJson();
+    DANT::ModuleHarness<BendModule> loaded;
+    loaded.module.dataFromJson(rootJ);
+    json_decref(rootJ);
+    setup_timed_bend(loaded, 1);
+    loaded.setParam(BendModule::BEAT_DIV_PARAM, 0.0f);
+    loaded.connectInput(BendModule::EXT_CLOCK_INPUT, 1, DANT::Cv::pulses(0.002, 0.05));
+    // triggered before a new interval is measured, so timed by the saved period instead of the 100ms length
+    CHECK(offset_at(loaded, 0.025) == Catch::Detail::Approx(0.5f).margin(0.002));
+
+    // Initialize forgets the saved period
+    harness.module.onReset();
+    CHECK(harness.module.clockFollower.period() == 0.0f);
+  }
+
+  SECTION("Clocked bends snap to the predicted beat") {
+    for (const double early : {0.005, -0.005, 0.02}) {
+      DANT::ModuleHarness<BendModule> harness;
+      setup_timed_bend(harness, 1);
+      harness.setParam(BendModule::BEAT_DIV_PARAM, 0.0f);  // 1 beat
+      harness.module.setConfigValue(&BendModule::BendConfig::snapToBeat, true);
+      harness.connectInput(BendModule::EXT_CLOCK_INPUT, 1, DANT::Cv::pulses(0.002, 0.05));
+      // triggered a little before or after the beat at 0.302s, or too far before it to snap
+      const double trigger{0.302 - early};
+      harness.connectInput(BendModule::BEND_TRIG_INPUT, 1, DANT::Cv::gate(trigger, 0.001));
+      while (harness.getSeconds() < trigger + 0.04) {
+        harness.step();
+      }
+      UNSCOPED_INFO("early [" << early << "]");
+      // snapped bends end on the next beat at 0.352s
+      const double duration{std::fabs(early) < 0.25 * 0.05 ? 0.352 - trigger : 0.05};
+      CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT) == Catch::Detail::Approx(0.04 / duration).margin(0.002));
+    }
+
+    // a division shorter than the beat snaps to the division, a 1/8 bend triggered 3ms after one ends on the next
+    DANT::ModuleHarness<BendModule> harness;
+    setup_timed_bend(harness, 1);
+    harness.setParam(BendModule::BEAT_DIV_PARAM, -2.0f);
+    harness.module.setConfigValue(&BendModule::BendConfig::snapToBeat, true);
+    harness.connectInput(BendModule::EXT_CLOCK_INPUT, 1, DANT::Cv::pulses(0.002, 0.05));
+    harness.connectInput(BendModule::BEND_TRIG_INPUT, 1, DANT::Cv::gate(0.33, 0.001));
+    while (harness.getSeconds() < 0.33 + 0.011) {
+      harness.step();
+    }
+    CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT) == Catch::Detail::Approx(0.5f).margin(0.002));
+  }
+
+  SECTION("Sub-sample trigger timing starts the bend where the trigger crossed its threshold") {
+    DANT::ModuleHarness<BendModule> sampled;
+    DANT::ModuleHarness<BendModule> subSample;
+    subSample.module.setConfigValue(&BendModule::BendConfig::subSampleOnset, true);
+    setup_timed_bend(sampled, 1);
+    setup_timed_bend(subSample, 1);
+
+    // the 10V trigger gate crosses 1V 0.9 samples before the first high sample, where the bend is 0.9 samples in,
+    // while the sampled bend starts a whole sample before it
+    const float oneSample{1.0f / (sampled.getSampleRate() * 0.1f)};
+    while (subSample.getOutput(BendModule::SIGNALS_OUTPUT, 0) == 0.0f && subSample.getSeconds() < BEND_START * 2.0) {
+      subSample.step();
+    }
+    CHECK(subSample.getOutput(BendModule::SIGNALS_OUTPUT, 0) == Catch::Detail::Approx(0.9f * oneSample).margin(1e-6));
+    for (const double seconds : {0.01, 0.05, 0.09}) {
+      UNSCOPED_INFO("seconds [" << seconds << "]");
+      CHECK(offset_at(sampled, seconds) - offset_at(subSample, seconds) ==
+            Catch::Detail::Approx(0.1f * oneSample).margin(1e-6));
+    }
+    CHECK(offset_at(subSample, 0.2) == Catch::Detail::Approx(1.0f).margin(FP_TOLERANCE_BEND));
+
+    json_t* rootJ = subSample.module.dataToJson();
+    DANT::ModuleHarness<BendModule> loaded;
+    loaded.module.dataFromJson(rootJ);
+    json_decref(rootJ);
+    CHECK(loaded.module.getConfig().subSampleOnset);
+  }
+
+  SECTION("Bends the signal of a chained module on its left") {
+    DANT::ModuleHarness<BendModule> left;
+    DANT::ModuleHarness<BendModule> harness;
+    left.connectInput(BendModule::SIGNALS_INPUT, 2, DANT::Cv::perChannel(0.0f, 0.25f));
+    setup_timed_bend(harness, 2);
+    harness.disconnectInput(BendModule::SIGNALS_INPUT);
+    harness.module.chain.setEnabled(true);
+    left.placeLeftOf(harness);
+    while (harness.getSeconds() < BEND_START + 0.2) {
+      left.step();
+      harness.step();
+    }
+
+    REQUIRE(harness.getOutputChannels(BendModule::SIGNALS_OUTPUT) == 2);
+    CHECK(offset_at(harness, 0.2, 1) == Catch::Detail::Approx(1.0f).margin(FP_TOLERANCE_BEND));
+
+    json_t* rootJ = harness.module.dataToJson();
+    DANT::ModuleHarness<BendModule> loaded;
+    CHECK_FALSE(loaded.module.chain.isEnabled());
+    loaded.module.dataFromJson(rootJ);
+    json_decref(rootJ);
+    CHECK(loaded.module.chain.isEnabled());
+    loaded.module.onReset();
+    CHECK_FALSE(loaded.module.chain.isEnabled());
+  }
+
+  SECTION("Sends its state to a state reader on its right") {
+    DANT::ModuleHarness<BendModule> harness;
+    DANT::ModuleHarness<StateReader> reader;
+    setup_timed_bend(harness, 2);
+    harness.setParam(BendModule::BEND_COMPLETION_PARAM, 0.0f);
+    harness.module.setConfigValue(&BendModule::BendConfig::unbendEnvelope, true);
+    harness.module.setConfigValue(&BendModule::BendConfig::unbendDurationPct, 0.5f);
+    harness.placeLeftOf(reader);
+    // the messages flip every frame, so the state read is the one the last frame sent
+    auto state = [&]() -> const DANT::BendPolyState& { return reader.module.bendState(reader.module); };
+    int endedFrames{0};
+    auto runUntil = [&](const double seconds) {
+      while (harness.getSeconds() < BEND_START + seconds) {
+        harness.step();
+        reader.step();
+        endedFrames += state().ended.test(0) ? 1 : 0;
+      }
+    };
+
+    runUntil(0.05);
+    CHECK(state().channels == 2);
+    CHECK(state().bending.bits == 0x3u);  // a mono trigger bends every channel
+    CHECK(state().progress[0][0] == Catch::Detail::Approx(0.5f).margin(0.001));
+    CHECK(state().envelope[0][0] == Catch::Detail::Approx(0.5f).margin(0.001));
+    runUntil(0.12);  // the 100ms bend returns over 50ms
+    CHECK(state().bending.bits == 0x0u);
+    CHECK(state().unbending.bits == 0x3u);
+    CHECK(state().envelope[0][0] == Catch::Detail::Approx(0.6f).margin(0.001));
+    CHECK(endedFrames == 0);
+    runUntil(0.2);
+    CHECK(state().unbending.bits == 0x0u);
+    CHECK(state().envelope[0][0] == 0.0f);
+    CHECK(endedFrames == 1);
+  }
+
+  SECTION("Sends idle states while bypassed") {
+    DANT::ModuleHarness<BendModule> harness;
+    DANT::ModuleHarness<StateReader> reader;
+    setup_timed_bend(harness, 2);
+    harness.placeLeftOf(reader);
+    auto state = [&]() -> const DANT::BendPolyState& { return reader.module.bendState(reader.module); };
+    int endedFrames{0};
+    auto run = [&](const int frames) {
+      for (int frame{0}; frame < frames; ++frame) {
+        harness.step();
+        reader.step();
+        endedFrames += state().ended.test(0) ? 1 : 0;
+      }
+    };
+    while (harness.getSeconds() < BEND_START + 0.05) {
+      run(1);
+    }
+    REQUIRE(state().bending.bits == 0x3u);
+
+    harness.setBypassed(true);
+    run(64);
+    CHECK(state().channels == 2);
+    CHECK(state().bending.bits == 0x0u);
+    CHECK(state().ended.bits == 0x0u);
+    CHECK(state().envelope[0][0] == 0.0f);
+    CHECK(endedFrames == 1);
+
+    // the bend carries on where it was, without ending again
+    harness.setBypassed(false);
+    run(2);
+    CHECK(state().bending.bits == 0x3u);
+    CHECK(endedFrames == 1);
+  }
+
+  SECTION("Sends the envelope a toggled release returns from") {
+    DANT::ModuleHarness<BendModule> harness;
+    DANT::ModuleHarness<StateReader> reader;
+    setup_timed_bend(harness, 1);
+    harness.setParam(BendModule::BEND_COMPLETION_PARAM, 1.0f);
+    harness.module.setConfigValue(&BendModule::BendConfig::holdMethod, BendModule::TOGGLE_TRIGGERS);
+    harness.module.setConfigValue(&BendModule::BendConfig::unbendEnvelope, true);
+    harness.module.setConfigValue(&BendModule::BendConfig::unbendDurationPct, 0.5f);
+    // the second trigger releases the bend half way
+    harness.connectInput(BendModule::BEND_TRIG_INPUT, 1, DANT::Cv::pulses(BEND_START, 0.05));
+    harness.placeLeftOf(reader);
+    auto state = [&]() -> const DANT::BendPolyState& { return reader.module.bendState(reader.module); };
+    auto runUntil = [&](const double seconds) {
+      while (harness.getSeconds() < BEND_START + seconds) {
+        harness.step();
+        reader.step();
+      }
+    };
+
+    runUntil(0.049);
+    CHECK(state().bending.bits == 0x1u);
+    const float released{state().envelope[0][0]};
+    CHECK(released == Catch::Detail::Approx(0.49f).margin(0.002));
+    runUntil(0.052);
+    CHECK(state().unbending.bits == 0x1u);
+    CHECK(state().envelope[0][0] == Catch::Detail::Approx(released).margin(0.03));
+    CHECK(state().envelope[0][0] < released);
+  }
+
+  SECTION("Sends its whole state every frame in mono block mode") {
+    DANT::ModuleHarness<BendModule> harness;
+    DANT::ModuleHarness<StateReader> reader;
+    harness.module.setConfigValue(&BendModule::BendConfig::monoBlockMode, true);
+    setup_timed_bend(harness, 1);
+    harness.placeLeftOf(reader);
+    while (harness.getSeconds() < BEND_START + 0.01) {
+      harness.step();
+      reader.step();
+    }
+
+    // the state advances every 4 frames, but every frame reads it, whichever message the engine flipped to
+    float previous{0.0f};
+    for (int frame{0}; frame < 64; ++frame) {
+      harness.step();
+      reader.step();
+      const DANT::BendPolyState& state = reader.module.bendState(reader.module);
+      UNSCOPED_INFO("frame [" << frame << "]");
+      CHECK(state.bending.bits == 0x1u);
+      CHECK(state.progress[0][0] >= previous);
+      CHECK(state.progress[0][0] == Catch::Detail::Approx(0.1f).margin(0.02));
+      CHECK(state.envelope[0][0] > 0.0f);
+      previous = state.progress[0][0];
+    }
+  }
+
+  SECTION("Holding lanes have reached their target") {
+    DANT::ModuleHarness<BendModule> harness;
+    DANT::ModuleHarness<StateReader> reader;
+    setup_timed_bend(harness, 1);
+    harness.placeLeftOf(reader);
+    while (harness.getSeconds() < BEND_START + 0.15) {
+      harness.step();
+      reader.step();
+    }
+    const DANT::BendPolyState& state = reader.module.bendState(reader.module);
+    CHECK(state.holding.bits == 0x1u);
+    CHECK(state.bending.bits == 0x0u);
+    CHECK(state.progress[0][0] == 1.0f);
+    CHECK(state.envelope[0][0] == Catch::Detail::Approx(1.0f));
+  }
+
+  SECTION("MIDI notes set the pitch and start bends on their own frame") {
+    DANT::ModuleHarness<BendModule> harness;
+    setup_timed_bend(harness, 4);  // the ports are ignored while MIDI is enabled
+    harness.module.setConfigValue(&BendModule::BendConfig::midiEnabled, true);
+    harness.module.setConfigValue(&BendModule::BendConfig::midiVoices, 2);
+    harness.module.setConfigValue(&BendModule::BendConfig::wheelToAmount, true);
+    const int64_t start{static_cast<int64_t>(BEND_START * harness.getSampleRate())};
+    harness.module.midiInput.onMessage(DANT::midiMessage(0x90, 72, 100, start));
+    // the wheel fully up adds an octave to the second note's bend
+    harness.module.midiInput.onMessage(DANT::midiMessage(0xe0, 0x7f, 0x7f, start + 1));
+    harness.module.midiInput.onMessage(DANT::midiMessage(0x90, 48, 100, start + 1));
+
+    while (harness.getFrame() < start) {
+      harness.step();
+    }
+    CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT, 0) == 0.0f);
+    harness.step();
+    CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT, 0) == Catch::Detail::Approx(1.0f).margin(0.001));
+    REQUIRE(harness.getOutputChannels(BendModule::SIGNALS_OUTPUT) == 2);
+    CHECK(offset_at(harness, 0.05) == Catch::Detail::Approx(1.5f).margin(0.001));
+    CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT, 1) == Catch::Detail::Approx(0.0f).margin(0.001));
+    CHECK(offset_at(harness, 0.2) == Catch::Detail::Approx(2.0f).margin(FP_TOLERANCE_BEND));
+    CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT, 1) == Catch::Detail::Approx(1.0f).margin(FP_TOLERANCE_BEND));
+
+    // a held note played again restarts its voice's bend, although the voice's gate never went low
+    harness.module.midiInput.onMessage(DANT::midiMessage(0x90, 72, 100, harness.getFrame()));
+    harness.step();
+    CHECK(harness.getOutput(BendModule::SIGNALS_OUTPUT, 0) == Catch::Detail::Approx(1.0f).margin(0.001));
+
+    json_t* rootJ = harness.module.dataToJson();
+    DANT::ModuleHarness<BendModule> loaded;
+    loaded.module.dataFromJson(rootJ);
+    json_decref(rootJ);
+    CHECK(loaded.module.getConfig().midiEnabled);
+    CHECK(loaded.module.getConfig().midiVoices == 2);
+    CHECK(loaded.module.getConfig().wheelToAmount);
+    CHECK_FALSE(loaded.module.getConfig().aftertouchToAmount);
+  }
+
+  SECTION("MIDI input can't be captured") {
+    const std::string path{"bend-midi-capture-test.dantcap"};
+    DANT::ModuleHarness<BendModule> harness;
+    CHECK(harness.module.captureBlocked().empty());
+    REQUIRE(harness.module.capture.start(path, "Bend", harness.getSampleRate(), harness.module));
+    harness.run(16);
+
+    // enabling MIDI ends the capture before the first note, and another can't start
+    harness.module.setConfigValue(&BendModule::BendConfig::midiEnabled, true);
+    CHECK_FALSE(harness.module.capture.isActive());
+    CHECK(harness.module.capture.getFrames() == 16u);
+    CHECK_FALSE(harness.module.captureBlocked().empty());
+    std::remove(path.c_str());
+  }
+
+  SECTION("Mono block mode follows the direct bend") {
+    const int frames{DANT::MONO_BLOCK_FRAMES};
+    // triggers landing anywhere in a block
+    for (int triggerFrame{0}; triggerFrame < frames; ++triggerFrame) {
+      DANT::ModuleHarness<BendModule> direct;
+      DANT::ModuleHarness<BendModule> blocked;
+      blocked.module.setConfigValue(&BendModule::BendConfig::monoBlockMode, true);
+      setup_timed_bend(direct, 1);
+      setup_timed_bend(blocked, 1);
+      const double triggerStart{BEND_START + ((triggerFrame + 0.5) / direct.getSampleRate())};
+      direct.connectInput(BendModule::BEND_TRIG_INPUT, 1, DANT::Cv::gate(triggerStart, 0.001));
+      blocked.connectInput(BendModule::BEND_TRIG_INPUT, 1, DANT::Cv::gate(triggerStart, 0.001));
+
+      const int numFrames{static_cast<int>(direct.getSampleRate() * (BEND_START + 0.15))};
+      std::vector<float> directOut{direct.collect(BendModule::SIGNALS_OUTPUT, 0, numFrames)};
+      std::vector<float> blockedOut{blocked.collect(BendModule::SIGNALS_OUTPUT, 0, numFrames)};
+
+      // the state machine advances once per 4 frames as they arrive, whatever the block length, so the blocked
+      // bend may lead by up to 4 frames plus the trigger
+      const float maxStep{5.0f / (direct.getSampleRate() * 0.1f)};
+      for (int i{frames}; i < numFrames; ++i) {
+        UNSCOPED_INFO("trigger frame [" << triggerFrame << "], frame [" << i << "]");
+        CHECK(blockedOut[i] == Catch::Detail::Approx(directOut[i - frames]).margin(maxStep));
+      }
+      CHECK(blockedOut.back() == Catch::Detail::Approx(1.0f).margin(FP_TOLERANCE_BEND));
+      // the grid meters the held bend at full intensity, although it's metered once per 4 frames
+      CHECK(blocked.module.gridSnapshot.read().rms[0][0] == Catch::Detail::Approx(1.0f).margin(0.001));
+    }
+  }
+}
+
+TEST_CASE("bend.cpp::BendModule real-time safety") {
+  REQUIRE(DANT::RtAudit::isInterposed());
+
+  const BendModule::HoldMethod holdMethods[]{BendModule::INDEFINITE, BendModule::AUTO_UNHOLD, BendModule::GATE_BENDS,
+                                             BendModule::TOGGLE_TRIGGERS};
+  for (const int numChannels : {1, 4, 16}) {
+    for (const int frames : {0, 4}) {
+      if (frames > 0 && numChannels > 1) {
+        continue;  // mono block mode only applies to mono signals
+      }
+      for (const bool clocked : {false, true}) {
+        SECTION("process() never allocates, locks or does file I/O, " + std::to_string(numChannels) + " channels, " +
+                std::to_string(frames) + " block frames" + (clocked ? ", clocked" : ", timed")) {
+          for (const BendModule::HoldMethod holdMethod : holdMethods) {
+            for (const bool unbendEnvelope : {false, true}) {
+              for (const float completion : {0.0f, 1.0f}) {
+                for (const float tracking : {0.0f, 1.0f}) {
+                  DANT::ModuleHarness<BendModule> harness;
+                  harness.module.setConfigValue(&BendModule::BendConfig::monoBlockMode, frames > 0);
+                  harness.module.setConfigValue(&BendModule::BendConfig::holdMethod, holdMethod);
+                  harness.module.setConfigValue(&BendModule::BendConfig::unbendEnvelope, unbendEnvelope);
+                  harness.module.setConfigValue(&BendModule::BendConfig::inverseUnbendShape, unbendEnvelope);
+                  harness.module.setConfigValue(&BendModule::BendConfig::autoUnholdThreshold, 0.1f);
+                  harness.module.setConfigValue(&BendModule::BendConfig::subSampleOnset, tracking > 0.0f);
+                  harness.setParam(BendModule::LENGTH_PARAM, 0.004f);
+                  harness.setParam(BendModule::BEND_COMPLETION_PARAM, completion);
+                  harness.setParam(BendModule::BEND_TRACKING_PARAM, tracking);
+                  harness.connectInput(BendModule::SIGNALS_INPUT, numChannels, DANT::Cv::sine(2.0f, 1.0f));
+                  harness.connectInput(BendModule::BEND_TRIG_INPUT, numChannels, DANT::Cv::pulses(BEND_START, 0.01));
+                  harness.connectInput(BendModule::RESET_INPUT, 1, DANT::Cv::pulses(BEND_START + 0.035, 0.05));
+                  // every beat division and shape across the channels
+                  harness.connectInput(BendModule::BEAT_DIV_CV_INPUT, numChannels, DANT::Cv::perChannel(-7.0f, 1.0f));
+                  harness.connectInput(BendModule::BEND_SHAPE_CV_INPUT, numChannels,
+                                       DANT::Cv::perChannel(-1.0f, 0.125f));
+                  if (clocked) {
+                    harness.connectInput(BendModule::EXT_CLOCK_INPUT, 1, DANT::Cv::pulses(0.002, 0.005));
+                  }
+                  harness.setRealtimeAudit(true);
+                  harness.run(static_cast<int>(harness.getSampleRate() * 0.05));
+
+                  UNSCOPED_INFO("hold method " << holdMethod << ", unbend " << unbendEnvelope << ", completion "
+                                               << completion << ", tracking " << tracking << ": "
+                                               << harness.describeRealtimeViolations());
+                  CHECK(harness.getRealtimeViolations() == 0u);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("bend.cpp::BendModule layout") {
+  std::unique_ptr<DANT::ModuleHarness<BendModule>> harness{new DANT::ModuleHarness<BendModule>()};
+  BendModule& module = harness->module;
+
+  // state the UI thread reads never shares a cache line with state the audio thread writes every sample
+  CHECK(DANT::isCacheAligned(&module));
+  CHECK(DANT::isCacheAligned(&module.gridSnapshot));
+  CHECK(DANT::isCacheAligned(&module.cvSnapshot));
+  CHECK(DANT::isCacheAligned(&module.eco));
+  CHECK(reinterpret_cast<const char*>(&module.eco) >=
+        reinterpret_cast<const char*>(&module.cvSnapshot) + sizeof(module.cvSnapshot));
+  // each continuous lane field is one cache line, the boolean lane state is packed into 16 bit masks
+  CHECK(DANT::isCacheAligned(module.lanes.startOffset));
+  CHECK(DANT::isCacheAligned(module.lanes.targetOffset));
+  CHECK(DANT::isCacheAligned(module.lanes.elapsedSeconds));
+  CHECK(DANT::isCacheAligned(module.lanes.totalSeconds));
+  CHECK(DANT::isCacheAligned(module.lanes.sampledInputPitch));
+  CHECK(sizeof(module.activeLanes) + sizeof(module.unbendingLanes) + sizeof(module.upLanes) == 6u);
+  CHECK(sizeof(module.resetTriggers) + sizeof(module.bendTriggers) == 4u);
+}
@@ -57,3 +57,66 @@ TEST_CASE("bend-voct.hpp::bendVoct") {
     }
   }
 }
+
+TEST_CASE("bend-voct.hpp::approxLog2") {
+  for (float x{1e-6f}; x <= 1.0f; x *= 1.37f) {
+    const rack::simd::float_4 in{x, x * 0.3f, x * 0.71f, x * 0.9f};
+    const rack::simd::float_4 out{DANT::approxLog2(in)};
+    for (int i{0}; i < 4; ++i) {
+      UNSCOPED_INFO("input [" << in[i] << "]");
+      CHECK(out[i] == Catch::Detail::Approx(std::log2(in[i])).margin(1e-4));
+    }
+  }
+}
+
+TEST_CASE("bend-voct.hpp::bendVoct ECO_MATH") {
+  const float CENT{1.0f / 1200.0f};
+
+  for (const float shape : {-1.0f, -0.5f, 0.0f, 0.5f, 1.0f}) {
+    for (const bool unbending : {false, true}) {
+      SECTION("Within a cent of PRECISE_MATH, 2 octave bend, shape " + std::to_string(shape) +
+              (unbending ? ", inverse unbend" : "")) {
+        DANT::BendOpts opts;
+        opts.startOffsets = rack::simd::float_4(0.0f);
+        opts.targetOffsets = rack::simd::float_4(2.0f);
+        opts.shape = rack::simd::float_4(shape);
+        opts.isUnbending = rack::simd::float_4(unbending ? 1.0f : 0.0f);
+        opts.inverseUnbend = unbending;
+        for (float p{0.0f}; p <= 1.0f; p += 0.001f) {
+          opts.progress = rack::simd::float_4(p, p * 0.01f, p * 0.5f, 1.0f - p);
+          opts.math = DANT::PRECISE_MATH;
+          const rack::simd::float_4 precise{DANT::bendVoct(rack::simd::float_4(1.0f), opts)};
+          opts.math = DANT::ECO_MATH;
+          const rack::simd::float_4 eco{DANT::bendVoct(rack::simd::float_4(1.0f), opts)};
+          for (int i{0}; i < 4; ++i) {
+            UNSCOPED_INFO("progress [" << opts.progress[i] << "]");
+            CHECK(eco[i] == Catch::Detail::Approx(precise[i]).margin(CENT));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("bend-voct.hpp::bendEnvelope") {
+  DANT::BendOpts opts;
+  opts.shape = rack::simd::float_4(1.0f);  // p^4
+  opts.progress = rack::simd::float_4(0.0f, 0.5f, 1.0f, 0.5f);
+
+  SECTION("Rises along the bend curve whatever the offsets") {
+    opts.startOffsets = rack::simd::float_4(-1.0f);
+    const rack::simd::float_4 envelope{DANT::bendEnvelope(opts, rack::simd::float_4(1.0f))};
+    CHECK(envelope[0] == 0.0f);
+    CHECK(envelope[1] == Catch::Detail::Approx(0.0625f));
+    CHECK(envelope[2] == Catch::Detail::Approx(1.0f));
+  }
+
+  SECTION("Unbends fall from the level they started at") {
+    opts.isUnbending = rack::simd::float_4(1.0f);
+    const rack::simd::float_4 envelope{DANT::bendEnvelope(opts, rack::simd::float_4(1.0f, 1.0f, 1.0f, 0.5f))};
+    CHECK(envelope[0] == 1.0f);
+    CHECK(envelope[1] == Catch::Detail::Approx(0.9375f));
+    CHECK(envelope[2] == Catch::Detail::Approx(0.0f).margin(1e-6));
+    CHECK(envelope[3] == Catch::Detail::Approx(0.46875f));
+  }
+}
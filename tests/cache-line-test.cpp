@@ -0,0 +1,34 @@
+#include "../src/dsp/cache-line.hpp"
+
+#include <memory>
+#include <rack.hpp>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+namespace {
+
+struct HotAndCold : DANT::CacheAligned {
+  int cold{1};
+  alignas(DANT::CACHE_LINE) float hot[3]{};
+};
+
+}  // namespace
+
+TEST_CASE("cache-line.hpp::CacheAligned") {
+  SECTION("Heap allocations start on a cache line") {
+    std::vector<std::unique_ptr<HotAndCold>> objects;
+    for (int i{0}; i < 64; ++i) {
+      objects.emplace_back(new HotAndCold);
+      UNSCOPED_INFO("object [" << i << "]");
+      CHECK(DANT::isCacheAligned(objects.back().get()));
+      CHECK(DANT::isCacheAligned(objects.back()->hot));
+      CHECK(objects.back()->cold == 1);
+    }
+  }
+
+  SECTION("Aligned members don't share a cache line with the members before them") {
+    CHECK(alignof(HotAndCold) == DANT::CACHE_LINE);
+    CHECK(sizeof(HotAndCold) == 2 * DANT::CACHE_LINE);
+  }
+}
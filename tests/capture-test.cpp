@@ -0,0 +1,134 @@
+#include "../src/shared/capture.hpp"
+
+#include <cstdio>
+#include <rack.hpp>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "mapped-file.hpp"
+
+namespace {
+
+struct CaptureTestModule : rack::engine::Module {
+  CaptureTestModule() { rack::engine::Module::config(2, 3, 0, 0); }
+};
+
+DANT::CaptureFrame frameWith(const float param, const int channels, const float voltage) {
+  DANT::CaptureFrame frame;
+  std::memset(&frame, 0, sizeof(frame));
+  frame.params[0] = param;
+  frame.params[1] = 1.0f;
+  for (int i{0}; i < 3; ++i) {
+    frame.channels[i] = static_cast<uint8_t>(channels);
+    for (int c{0}; c < channels; ++c) {
+      frame.voltages[i][c] = voltage + static_cast<float>(c);
+    }
+  }
+  return frame;
+}
+
+}  // namespace
+
+TEST_CASE("capture.hpp::CaptureEncoder") {
+  const DANT::CaptureHeader header{DANT::captureHeader("Test", 48000.0f, 2, 3)};
+  std::vector<uint8_t> data(reinterpret_cast<const uint8_t*>(&header),
+                            reinterpret_cast<const uint8_t*>(&header) + sizeof(header));
+  std::vector<DANT::CaptureFrame> frames;
+  for (int i{0}; i < 100; ++i) {
+    frames.push_back(frameWith(0.5f, 4, 1.0f));  // unchanged run
+  }
+  frames.push_back(frameWith(0.75f, 4, 1.0f));  // param change
+  frames.push_back(frameWith(0.75f, 16, 1.0f));  // channel count change
+  frames.push_back(frameWith(0.75f, 16, -2.0f));  // voltage change
+  frames.push_back(frameWith(0.75f, 16, -2.0f));
+
+  DANT::CaptureEncoder encoder(2, 3);
+  for (const DANT::CaptureFrame& frame : frames) {
+    encoder.encode(frame, data);
+  }
+  encoder.flush(data);
+
+  SECTION("Unchanged frames pack into one record") {
+    const size_t firstFrame{4u + (2u * sizeof(float)) + (3u * (1u + (4u * sizeof(float))))};
+    const size_t paramChange{4u + sizeof(float)};
+    const size_t inputsChange{4u + (3u * (1u + (16u * sizeof(float))))};
+    CHECK(data.size() == sizeof(header) + firstFrame + 4u + paramChange + (2u * inputsChange) + 4u);
+  }
+
+  SECTION("Decoded frames match the encoded frames") {
+    DANT::CaptureDecoder decoder;
+    REQUIRE(decoder.open(data.data(), data.size()));
+    CHECK(std::string(decoder.getHeader().slug) == "Test");
+    CHECK(decoder.getHeader().sampleRate == 48000.0f);
+
+    DANT::CaptureFrame decoded;
+    for (size_t f{0}; f < frames.size(); ++f) {
+      UNSCOPED_INFO("frame [" << f << "]");
+      REQUIRE(decoder.next(decoded));
+      CHECK(decoded.params[0] == frames[f].params[0]);
+      CHECK(decoded.params[1] == frames[f].params[1]);
+      for (int i{0}; i < 3; ++i) {
+        CHECK(decoded.channels[i] == frames[f].channels[i]);
+        CHECK(std::memcmp(decoded.voltages[i], frames[f].voltages[i], frames[f].channels[i] * sizeof(float)) == 0);
+      }
+    }
+    CHECK_FALSE(decoder.next(decoded));
+  }
+
+  SECTION("Other data is rejected, truncated data ends the capture") {
+    DANT::CaptureDecoder decoder;
+    std::vector<uint8_t> notCapture(data);
+    notCapture[0] = 'X';
+    CHECK_FALSE(decoder.open(notCapture.data(), notCapture.size()));
+
+    REQUIRE(decoder.open(data.data(), sizeof(header) + 10u));
+    DANT::CaptureFrame decoded;
+    CHECK_FALSE(decoder.next(decoded));
+  }
+}
+
+TEST_CASE("capture.hpp::Capture") {
+  const std::string path{"capture-test.dantcap"};
+  CaptureTestModule module;
+  module.inputs[1].channels = 2;
+
+  DANT::Capture capture;
+  CHECK_FALSE(capture.isActive());
+  capture.record(module);  // ignored while inactive
+  REQUIRE(capture.start(path, "Test", 44100.0f, module));
+  REQUIRE(capture.isActive());
+
+  const int numFrames{static_cast<int>(DANT::Capture::RING_FRAMES) / 2};
+  for (int f{0}; f < numFrames; ++f) {
+    module.params[0].setValue(static_cast<float>(f / 100));
+    module.inputs[1].voltages[0] = static_cast<float>(f);
+    module.inputs[1].voltages[1] = -static_cast<float>(f);
+    capture.record(module);
+  }
+  capture.stop();
+  CHECK_FALSE(capture.isActive());
+  CHECK(capture.getFrames() == static_cast<uint64_t>(numFrames));
+  CHECK(capture.getDropped() == 0u);
+
+  {
+    DANT::MappedFile file(path);
+    REQUIRE(file.isOpen());
+    DANT::CaptureDecoder decoder;
+    REQUIRE(decoder.open(file.data(), file.size()));
+    CHECK(decoder.getHeader().sampleRate == 44100.0f);
+    CHECK(decoder.getHeader().numParams == 2);
+    CHECK(decoder.getHeader().numInputs == 3);
+
+    DANT::CaptureFrame frame;
+    int decoded{0};
+    while (decoder.next(frame)) {
+      UNSCOPED_INFO("frame [" << decoded << "]");
+      CHECK(frame.params[0] == static_cast<float>(decoded / 100));
+      CHECK(frame.channels[1] == 2);
+      CHECK(frame.voltages[1][1] == -static_cast<float>(decoded));
+      ++decoded;
+    }
+    CHECK(decoded == numFrames);
+  }
+  std::remove(path.c_str());
+}
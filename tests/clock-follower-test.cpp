@@ -0,0 +1,114 @@
+#include "../src/dsp/clock-follower.hpp"
+
+#include <cmath>
+#include <rack.hpp>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+namespace {
+
+const float SAMPLE_RATE{48000.0f};
+const float SAMPLE_TIME{1.0f / SAMPLE_RATE};
+
+// a clock idling at -5V whose rising edges ramp to 10V over 6 samples, crossing 1V at each of the edge times
+struct RampClock {
+  std::vector<double> edges;
+
+  float voltage(const double seconds) const {
+    for (const double edge : this->edges) {
+      const double sinceEdge{seconds - edge};
+      if (sinceEdge >= -0.001 && sinceEdge < 0.005) {
+        return static_cast<float>(rack::math::clamp(1.0 + (sinceEdge * SAMPLE_RATE * 2.5), -5.0, 10.0));
+      }
+    }
+    return -5.0f;
+  }
+};
+
+// edges every period seconds from start, shifted by the offsets, one per edge, when given
+std::vector<double> clockEdges(const double start, const double period, const int count,
+                               const std::vector<double>& offsets = {}) {
+  std::vector<double> edges;
+  for (int i{0}; i < count; ++i) {
+    edges.push_back(start + (period * i) + (i < static_cast<int>(offsets.size()) ? offsets[i] : 0.0));
+  }
+  return edges;
+}
+
+// runs the follower over the clock from sample start until seconds, returns the next sample
+int follow(DANT::ClockFollower& follower, const RampClock& clock, const int start, const double seconds) {
+  int i{start};
+  for (; i * static_cast<double>(SAMPLE_TIME) < seconds; ++i) {
+    follower.process(clock.voltage(i * static_cast<double>(SAMPLE_TIME)), SAMPLE_TIME);
+  }
+  return i;
+}
+
+}  // namespace
+
+TEST_CASE("clock-follower.hpp::ClockFollower") {
+  DANT::ClockFollower follower;
+
+  SECTION("No period until an interval is measured") {
+    RampClock clock{clockEdges(0.01, 0.3, 1)};
+    follow(follower, clock, 0, 0.2);
+    CHECK(follower.period() == 0.0f);
+    CHECK(follower.phase() == 0.0f);
+  }
+
+  SECTION("Locks to a clock between samples, with sub-sample accuracy") {
+    const double period{0.2173};  // 10430.4 samples
+    RampClock clock{clockEdges(0.01, period, 6)};
+    const int next{follow(follower, clock, 0, 0.01 + period + 0.001)};
+    CHECK(follower.period() == Catch::Detail::Approx(period).margin(1e-6));
+    follow(follower, clock, next, 0.01 + (period * 5.5));
+    CHECK(follower.period() == Catch::Detail::Approx(period).margin(1e-6));
+    CHECK(follower.phase() == Catch::Detail::Approx(0.5).margin(0.001));
+    CHECK(follower.nextEdge() == Catch::Detail::Approx(period * 0.5).margin(1e-4));
+  }
+
+  SECTION("Smooths jitter") {
+    const double period{0.25};
+    const std::vector<double> jitter{0.0, 0.0, 4e-4, -4e-4, 4e-4, -4e-4, 4e-4, -4e-4, 4e-4, -4e-4};
+    RampClock clock{clockEdges(0.01, period, static_cast<int>(jitter.size()), jitter)};
+    follow(follower, clock, 0, 0.01 + (period * 9.5));
+    // the raw intervals are 0.8ms from the period
+    CHECK(follower.period() == Catch::Detail::Approx(period).margin(4e-4));
+  }
+
+  SECTION("A missed pulse and an extra pulse don't change the period") {
+    const double period{0.25};
+    std::vector<double> edges{clockEdges(0.01, period, 10)};
+    edges.erase(edges.begin() + 4);
+    edges.push_back(0.01 + (period * 6.4));
+    RampClock clock{edges};
+    follow(follower, clock, 0, 0.01 + (period * 9.5));
+    CHECK(follower.period() == Catch::Detail::Approx(period).margin(1e-5));
+  }
+
+  SECTION("Relocks to a new tempo") {
+    std::vector<double> edges{clockEdges(0.01, 0.25, 4)};
+    for (const double edge : clockEdges(0.01 + (0.25 * 4), 0.125, 8)) {
+      edges.push_back(edge);
+    }
+    RampClock clock{edges};
+    follow(follower, clock, 0, 0.01 + (0.25 * 4) + (0.125 * 7.5));
+    CHECK(follower.period() == Catch::Detail::Approx(0.125).margin(1e-5));
+  }
+
+  SECTION("A restored period is kept until the first interval is measured, then replaced") {
+    follower.restore(0.5f);
+    CHECK(follower.period() == 0.5f);
+    RampClock clock{clockEdges(0.01, 0.2, 3)};
+    const int next{follow(follower, clock, 0, 0.1)};
+    CHECK(follower.period() == 0.5f);
+    follow(follower, clock, next, 0.3);
+    CHECK(follower.period() == Catch::Detail::Approx(0.2).margin(1e-6));
+
+    follower.restart();
+    CHECK(follower.period() == Catch::Detail::Approx(0.2).margin(1e-6));
+    follower.reset();
+    CHECK(follower.period() == 0.0f);
+  }
+}
@@ -0,0 +1,43 @@
+#include "../src/shared/eco-mode.hpp"
+
+#include <rack.hpp>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("eco-mode.hpp::EcoMode") {
+  DANT::EcoMode eco;
+
+  SECTION("CVs are read every sample unless in Eco mode") {
+    CHECK_FALSE(eco.update());
+    CHECK(eco.snapshotDivision() == DANT::SNAPSHOT_DIVISION);
+    for (int i{0}; i < 100; ++i) {
+      CHECK(eco.readCvs());
+    }
+  }
+
+  SECTION("Eco mode reads CVs at once, then every ECO_CV_DIVISION samples") {
+    DANT::ECO_MODE.store(true);
+    CHECK(eco.update());
+    CHECK_FALSE(eco.update());
+    CHECK(eco.enabled);
+    CHECK(eco.snapshotDivision() == DANT::ECO_SNAPSHOT_DIVISION);
+
+    int reads{0};
+    for (uint32_t i{0u}; i < DANT::ECO_CV_DIVISION * 4u; ++i) {
+      if (eco.readCvs()) {
+        CHECK(i % DANT::ECO_CV_DIVISION == 0u);
+        ++reads;
+      }
+    }
+    CHECK(reads == 4);
+
+    // leaving Eco mode goes straight back to every sample
+    eco.readCvs();
+    DANT::ECO_MODE.store(false);
+    CHECK(eco.update());
+    CHECK(eco.readCvs());
+    CHECK(eco.readCvs());
+    CHECK(eco.snapshotDivision() == DANT::SNAPSHOT_DIVISION);
+  }
+  DANT::ECO_MODE.store(DANT::DEFAULT_ECO_MODE);
+}
@@ -0,0 +1,107 @@
+#include "../src/shared/expander-chain.hpp"
+
+#include <rack.hpp>
+
+#include "catch2/catch.hpp"
+#include "module-harness.hpp"
+
+namespace {
+
+// adds 1V to its signal, like a chained DanT module
+struct Relay : rack::engine::Module, DANT::Chained {
+  Relay() {
+    config(0, 1, 1, 0);
+    chain.attach(*this);
+  }
+
+  void onExpanderChange(const ExpanderChangeEvent& e) override { chain.link(*this); }
+
+  void process(const ProcessArgs& args) override {
+    rack::engine::Input& signal = chain.input(*this, inputs[0]);
+    outputs[0].channels = signal.channels;
+    for (int c{0}; c < signal.getChannels(); ++c) {
+      outputs[0].voltages[c] = signal.voltages[c] + 1.0f;
+    }
+    chain.send(*this, outputs[0]);
+  }
+};
+
+// any other module
+struct Other : rack::engine::Module {
+  Other() { config(0, 1, 1, 0); }
+};
+
+}  // namespace
+
+TEST_CASE("expander-chain.hpp::ExpanderChain") {
+  DANT::ModuleHarness<Relay> left;
+  DANT::ModuleHarness<Relay> right;
+  left.connectInput(0, 3, DANT::Cv::perChannel(0.0f, 1.0f));
+  right.module.chain.setEnabled(true);
+
+  SECTION("A chained module reads its left neighbour's output a frame later") {
+    left.placeLeftOf(right);
+    CHECK(left.module.chain.isChainedRight());
+    CHECK(right.module.chain.isChainedLeft());
+
+    left.step();
+    right.step();
+    CHECK(right.getOutputChannels(0) == 0);
+    left.step();
+    right.step();
+    REQUIRE(right.getOutputChannels(0) == 3);
+    for (int c{0}; c < 3; ++c) {
+      UNSCOPED_INFO("channel [" << c << "]");
+      CHECK(right.getOutput(0, c) == static_cast<float>(c) + 2.0f);
+    }
+  }
+
+  SECTION("Nothing is chained until the receiving module enables it") {
+    right.module.chain.setEnabled(false);
+    left.placeLeftOf(right);
+    left.run(2);
+    right.run(2);
+    CHECK(right.getOutputChannels(0) == 0);
+
+    // enabled later, it starts from the signal sent after it was enabled, a frame later
+    right.module.chain.setEnabled(true);
+    left.step();
+    right.step();
+    CHECK(right.getOutputChannels(0) == 0);
+    left.step();
+    right.step();
+    CHECK(right.getOutputChannels(0) == 3);
+  }
+
+  SECTION("A patched input takes priority over the chain") {
+    left.placeLeftOf(right);
+    right.connectInput(0, 1, DANT::Cv::constant(5.0f));
+    left.run(2);
+    right.run(2);
+    REQUIRE(right.getOutputChannels(0) == 1);
+    CHECK(right.getOutput(0) == 6.0f);
+  }
+
+  SECTION("Moving the modules apart unchains them") {
+    left.placeLeftOf(right);
+    left.run(2);
+    right.run(2);
+    left.placeLeftOf(right, false);
+    CHECK_FALSE(right.module.chain.isChainedLeft());
+    right.step();
+    CHECK(right.getOutputChannels(0) == 0);
+
+    // placed together again, the old signal isn't read before the new one arrives
+    left.placeLeftOf(right);
+    right.step();
+    CHECK(right.getOutputChannels(0) == 0);
+  }
+
+  SECTION("Only chains to DanT modules") {
+    DANT::ModuleHarness<Other> other;
+    left.placeLeftOf(other);
+    CHECK_FALSE(left.module.chain.isChainedRight());
+    other.placeLeftOf(right);
+    CHECK_FALSE(right.module.chain.isChainedLeft());
+  }
+}
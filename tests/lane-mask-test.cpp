@@ -0,0 +1,110 @@
+#include "../src/dsp/lane-mask.hpp"
+
+#include <rack.hpp>
+#include <string>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("lane-mask.hpp::validLanes") {
+  CHECK(DANT::validLanes(0, 0) == 0x0);
+  CHECK(DANT::validLanes(1, 0) == 0x1);
+  CHECK(DANT::validLanes(6, 0) == 0xF);
+  CHECK(DANT::validLanes(6, 1) == 0x3);
+  CHECK(DANT::validLanes(6, 2) == 0x0);
+  CHECK(DANT::validLanes(16, 3) == 0xF);
+}
+
+TEST_CASE("lane-mask.hpp::LaneMask") {
+  DANT::LaneMask lanes;
+  lanes.set(1, true);
+  lanes.set(6, true);
+  lanes.set(15, true);
+  CHECK(lanes.bits == 0x8042u);
+  CHECK(lanes.test(6));
+  CHECK_FALSE(lanes.test(7));
+  CHECK(lanes.block(0) == 0x2);
+  CHECK(lanes.block(1) == 0x4);
+  CHECK(lanes.block(3) == 0x8);
+
+  SECTION("Block masks match the lane bits") {
+    for (int block{0}; block < DANT::SIMD; ++block) {
+      CHECK(rack::simd::movemask(lanes.mask(block)) == lanes.block(block));
+      CHECK(rack::simd::movemask(lanes.unsetMask(block)) == (DANT::BLOCK_BITS & ~lanes.block(block)));
+    }
+  }
+
+  SECTION("Comparison masks set and clear only the selected lanes") {
+    lanes.set(2, rack::simd::float_4(1.0f, 0.0f, 1.0f, 0.0f) > 0.5f, true);
+    CHECK(lanes.bits == 0x8542u);
+    lanes.set(0, rack::simd::float_4(1.0f) > 0.5f, false);
+    CHECK(lanes.bits == 0x8540u);
+    lanes.set(6, false);
+    CHECK(lanes.bits == 0x8500u);
+    lanes.clear();
+    CHECK(lanes.bits == 0u);
+  }
+}
+
+TEST_CASE("lane-mask.hpp::TriggerLanes") {
+  SECTION("Fires like rack::dsp::SchmittTrigger on every lane") {
+    DANT::TriggerLanes triggers;
+    rack::dsp::SchmittTrigger reference[DANT::CHANS];
+    for (int i{0}; i < 256; ++i) {
+      for (int block{0}; block < DANT::SIMD; ++block) {
+        rack::simd::float_4 in;
+        for (int lane{0}; lane < DANT::SIMD; ++lane) {
+          // each lane a different period and pattern, crossing between and beyond the thresholds
+          const int channel{(block * DANT::SIMD) + lane};
+          in[lane] = static_cast<float>((i * (channel + 3)) % 7) * 0.4f - 0.8f;
+        }
+        const int fired{triggers.process(block, in)};
+        for (int lane{0}; lane < DANT::SIMD; ++lane) {
+          const int channel{(block * DANT::SIMD) + lane};
+          UNSCOPED_INFO("sample [" << i << "] channel [" << channel << "]");
+          CHECK(((fired >> lane) & 1) == (reference[channel].process(in[lane]) ? 1 : 0));
+          CHECK(triggers.isHigh(channel) == reference[channel].isHigh());
+        }
+      }
+    }
+  }
+
+  SECTION("Starts high, an input must go low before it fires") {
+    DANT::TriggerLanes triggers;
+    CHECK(triggers.process(0, rack::simd::float_4(10.0f)) == 0);
+    CHECK(triggers.process(0, rack::simd::float_4(0.0f)) == 0);
+    CHECK(triggers.process(0, rack::simd::float_4(10.0f)) == DANT::BLOCK_BITS);
+  }
+
+  SECTION("Lanes outside the selection keep their state") {
+    DANT::TriggerLanes triggers;
+    triggers.process(1, rack::simd::float_4(0.0f), 0x3);
+    CHECK(triggers.high == 0xFFCFu);
+    CHECK(triggers.process(1, rack::simd::float_4(5.0f), 0x1) == 0x1);
+    CHECK(triggers.high == 0xFFDFu);
+    triggers.reset();
+    CHECK(triggers.high == 0xFFFFu);
+  }
+
+  SECTION("A rearmed lane fires while its input stays high") {
+    DANT::TriggerLanes triggers;
+    triggers.process(0, rack::simd::float_4(0.0f));
+    CHECK(triggers.process(0, rack::simd::float_4(10.0f)) == DANT::BLOCK_BITS);
+    triggers.rearm(2);
+    CHECK(triggers.process(0, rack::simd::float_4(10.0f)) == 0x4);
+    CHECK(triggers.process(0, rack::simd::float_4(10.0f)) == 0);
+  }
+}
+
+TEST_CASE("lane-mask.hpp::onsetDelay") {
+  // a step, a rise crossing halfway, a rise crossing at the current sample, a fall
+  const rack::simd::float_4 previous{0.0f, 0.5f, 0.0f, 5.0f};
+  const rack::simd::float_4 in{10.0f, 1.5f, 1.0f, 2.0f};
+  const rack::simd::float_4 delay{DANT::onsetDelay(previous, in)};
+  CHECK(delay[0] == Catch::Detail::Approx(0.9f));
+  CHECK(delay[1] == Catch::Detail::Approx(0.5f));
+  CHECK(delay[2] == 0.0f);
+  CHECK(delay[3] == 0.0f);
+
+  // never more than a sample, e.g. when the previous input was already above the threshold
+  CHECK(DANT::onsetDelay(rack::simd::float_4(2.0f), rack::simd::float_4(3.0f))[0] == 1.0f);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DANT {
+
+/**
+ * Read only view of a whole file, memory mapped so large captures replay without being read up front.
+ * On Windows the file is read into memory instead.
+ */
+struct MappedFile {
+  explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+    std::FILE* file{std::fopen(path.c_str(), "rb")};
+    if (!file) {
+      return;
+    }
+    std::fseek(file, 0, SEEK_END);
+    this->buffer.resize(static_cast<size_t>(std::ftell(file)));
+    std::fseek(file, 0, SEEK_SET);
+    this->open = std::fread(this->buffer.data(), 1, this->buffer.size(), file) == this->buffer.size();
+    std::fclose(file);
+    this->bytes = this->buffer.data();
+    this->length = this->buffer.size();
+#else
+    const int fd{::open(path.c_str(), O_RDONLY)};
+    if (fd < 0) {
+      return;
+    }
+    struct stat status;
+    if (fstat(fd, &status) == 0 && status.st_size > 0) {
+      void* mapped{mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0)};
+      if (mapped != MAP_FAILED) {
+        madvise(mapped, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+        this->bytes = static_cast<const uint8_t*>(mapped);
+        this->length = static_cast<size_t>(status.st_size);
+        this->open = true;
+      }
+    }
+    ::close(fd);
+#endif
+  }
+
+  ~MappedFile() {
+#if !defined(_WIN32)
+    if (this->open) {
+      munmap(const_cast<uint8_t*>(this->bytes), this->length);
+    }
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool isOpen() const { return this->open; }
+
+  const uint8_t* data() const { return this->bytes; }
+
+  size_t size() const { return this->length; }
+
+ private:
+  bool open{false};
+  const uint8_t* bytes{nullptr};
+  size_t length{0};
+#if defined(_WIN32)
+  std::vector<uint8_t> buffer;
+#endif
+};
+
+}  // namespace DANT
@@ -0,0 +1,89 @@
+#include "../src/dsp/midi-voices.hpp"
+
+#include <rack.hpp>
+
+#include "catch2/catch.hpp"
+#include "module-harness.hpp"
+
+namespace {
+
+int noteOn(DANT::MidiVoices& voices, const uint8_t note) {
+  return voices.process(DANT::midiMessage(0x90, note, 100));
+}
+
+void noteOff(DANT::MidiVoices& voices, const uint8_t note) { voices.process(DANT::midiMessage(0x80, note, 0)); }
+
+}  // namespace
+
+TEST_CASE("midi-voices.hpp::MidiVoices") {
+  DANT::MidiVoices voices;
+  voices.setVoices(3);
+
+  SECTION("Notes take the next free voice and keep their pitch after release") {
+    CHECK(noteOn(voices, 60) == 0);
+    CHECK(noteOn(voices, 72) == 1);
+    CHECK(voices.gates.bits == 0x3u);
+    CHECK(voices.pitch(1) == 1.0f);
+    noteOff(voices, 60);
+    CHECK(voices.gates.bits == 0x2u);
+    CHECK(voices.pitch(0) == 0.0f);
+    // voice 0 is free, but the rotation continues after the last voice assigned
+    CHECK(noteOn(voices, 48) == 2);
+    CHECK(voices.pitch(2) == -1.0f);
+    CHECK(noteOn(voices, 50) == 0);
+  }
+
+  SECTION("A note on with velocity 0 is a note off") {
+    noteOn(voices, 60);
+    CHECK(voices.process(DANT::midiMessage(0x90, 60, 0)) == -1);
+    CHECK(voices.gates.bits == 0x0u);
+  }
+
+  SECTION("With every voice held the oldest note is stolen, a held note retriggers its voice") {
+    noteOn(voices, 60);
+    noteOn(voices, 62);
+    noteOn(voices, 64);
+    CHECK(noteOn(voices, 62) == 1);
+    CHECK(noteOn(voices, 65) == 0);
+    CHECK(voices.pitch(0) == Catch::Detail::Approx(5.0f / 12.0f));
+    CHECK(noteOn(voices, 67) == 2);
+    // the stolen note's release doesn't release its voice
+    noteOff(voices, 60);
+    CHECK(voices.gates.bits == 0x7u);
+  }
+
+  SECTION("Fewer voices release the voices above") {
+    noteOn(voices, 60);
+    noteOn(voices, 62);
+    noteOn(voices, 64);
+    voices.setVoices(2);
+    CHECK(voices.getVoices() == 2);
+    CHECK(voices.gates.bits == 0x3u);
+    voices.setVoices(0);
+    CHECK(voices.getVoices() == 1);
+  }
+
+  SECTION("Pitch wheel, aftertouch and all notes off") {
+    voices.process(DANT::midiMessage(0xe0, 0x7f, 0x7f));
+    CHECK(voices.wheel == 1.0f);
+    voices.process(DANT::midiMessage(0xe0, 0x00, 0x40));
+    CHECK(voices.wheel == 0.0f);
+    voices.process(DANT::midiMessage(0xe0, 0x00, 0x00));
+    CHECK(voices.wheel == -1.0f);
+
+    noteOn(voices, 60);
+    noteOn(voices, 64);
+    voices.process(DANT::midiMessage(0xa0, 64, 127));
+    CHECK(voices.pressure[0] == 0.0f);
+    CHECK(voices.pressure[1] == 1.0f);
+    voices.process(DANT::midiMessage(0xd0, 0, 0));
+    CHECK(voices.pressure[1] == 0.0f);
+
+    voices.process(DANT::midiMessage(0xb0, 123, 0));
+    CHECK(voices.gates.bits == 0x0u);
+
+    voices.reset();
+    CHECK(voices.pitch(0) == 0.0f);
+    CHECK(noteOn(voices, 60) == 0);
+  }
+}
@@ -0,0 +1,70 @@
+#include "module-harness.hpp"
+
+#include <rack.hpp>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+// the plugin globals the module tests link against, compiled once into the test runner
+#include "../src/plugin.cpp"
+
+// copies each input channel to the output and counts process calls
+struct EchoModule : rack::engine::Module {
+  enum InputIds { SIGNAL_INPUT, NUM_INPUTS };
+  enum OutputIds { SIGNAL_OUTPUT, NUM_OUTPUTS };
+
+  int processCalls{0};
+  float lastSampleTime{0.0f};
+
+  EchoModule() { rack::engine::Module::config(0, NUM_INPUTS, NUM_OUTPUTS, 0); }
+
+  void process(const rack::engine::Module::ProcessArgs& args) override {
+    const int numChannels{inputs[SIGNAL_INPUT].getChannels()};
+    for (int c{0}; c < numChannels; ++c) {
+      outputs[SIGNAL_OUTPUT].setVoltage(inputs[SIGNAL_INPUT].getVoltage(c), c);
+    }
+    outputs[SIGNAL_OUTPUT].setChannels(numChannels);
+    lastSampleTime = args.sampleTime;
+    ++processCalls;
+  }
+};
+
+TEST_CASE("module-harness.hpp::ModuleHarness") {
+  SECTION("Sources are evaluated per channel at the frame time") {
+    DANT::ModuleHarness<EchoModule> harness(1000.0f);
+    harness.connectInput(EchoModule::SIGNAL_INPUT, 3, DANT::Cv::perChannel(1.0f, 2.0f));
+    harness.step();
+
+    CHECK(harness.getOutputChannels(EchoModule::SIGNAL_OUTPUT) == 3);
+    CHECK(harness.getOutput(EchoModule::SIGNAL_OUTPUT, 0) == 1.0f);
+    CHECK(harness.getOutput(EchoModule::SIGNAL_OUTPUT, 2) == 5.0f);
+
+    harness.connectInput(EchoModule::SIGNAL_INPUT, 1, DANT::Cv::gate(0.005, 0.002));
+    std::vector<float> collected{harness.collect(EchoModule::SIGNAL_OUTPUT, 0, 10)};
+
+    std::vector<float> expected{0.0f, 0.0f, 0.0f, 0.0f, 10.0f, 10.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    CHECK(collected == expected);
+    CHECK(harness.getFrame() == 11);
+    CHECK(harness.module.processCalls == 11);
+  }
+
+  SECTION("Sample rate is passed to process") {
+    DANT::ModuleHarness<EchoModule> harness(96000.0f);
+    harness.run(4);
+
+    CHECK(harness.module.lastSampleTime == Catch::Detail::Approx(1.0f / 96000.0f));
+    CHECK(harness.getSeconds() == Catch::Detail::Approx(4.0 / 96000.0));
+  }
+
+  SECTION("Disconnected inputs read zero channels") {
+    DANT::ModuleHarness<EchoModule> harness;
+    harness.connectInput(EchoModule::SIGNAL_INPUT, 2, DANT::Cv::constant(3.0f));
+    harness.step();
+    harness.disconnectInput(EchoModule::SIGNAL_INPUT);
+    harness.step();
+
+    CHECK(harness.module.inputs[EchoModule::SIGNAL_INPUT].getChannels() == 0);
+    // Rack keeps a connected output at 1 channel at least
+    CHECK(harness.getOutputChannels(EchoModule::SIGNAL_OUTPUT) == 1);
+  }
+}
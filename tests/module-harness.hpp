@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>  // std::fill
+#include <climits>    // INT_MAX
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <rack.hpp>
+#include <utility>  // std::swap
+#include <vector>
+
+#include "../src/dsp/cache-line.hpp"
+#include "../src/plugin.hpp"
+#include "../src/shared/capture.hpp"
+#include "../src/static.hpp"
+#include "rt-audit.hpp"
+
+namespace DANT {
+
+/**
+ * Synthetic CV sources, a source returns the voltage for a channel at a time in seconds.
+ */
+typedef std::function<float(const double seconds, const int channel)> CvSource;
+
+namespace Cv {
+
+inline CvSource constant(const float voltage) {
+  return [=](const double seconds, const int channel) { return voltage; };
+}
+
+// a different constant voltage per channel, channel 0 starts at voltage
+inline CvSource perChannel(const float voltage, const float channelStep) {
+  return [=](const double seconds, const int channel) { return voltage + (channelStep * static_cast<float>(channel)); };
+}
+
+inline CvSource sine(const float frequency, const float amplitude) {
+  return [=](const double seconds, const int channel) {
+    return amplitude * static_cast<float>(std::sin(2.0 * DANT::PI * frequency * seconds));
+  };
+}
+
+// high (10V) from start for width seconds, then low
+inline CvSource gate(const double start, const double width) {
+  return [=](const double seconds, const int channel) {
+    return (seconds >= start && seconds < start + width) ? 10.0f : 0.0f;
+  };
+}
+
+// 1ms 10V trigger every period seconds, starting at start
+inline CvSource pulses(const double start, const double period) {
+  return [=](const double seconds, const int channel) {
+    return (seconds >= start && std::fmod(seconds - start, period) < 0.001) ? 10.0f : 0.0f;
+  };
+}
+
+}  // namespace Cv
+
+// a 3 byte MIDI message, status includes the channel, e.g. 0x90 is a note on, channel 1, due at frame
+inline rack::midi::Message midiMessage(const uint8_t status, const uint8_t data1, const uint8_t data2,
+                                       const int64_t frame = 0) {
+  rack::midi::Message message;
+  message.bytes = {status, data1, data2};
+  message.frame = frame;
+  return message;
+}
+
+// turns the plugin wide Eco mode setting on for a scope, modules pick it up at their next process()
+struct ScopedEcoMode {
+  ScopedEcoMode() { DANT::ECO_MODE.store(true); }
+  ~ScopedEcoMode() { DANT::ECO_MODE.store(DANT::DEFAULT_ECO_MODE); }
+};
+
+/**
+ * Headless harness, owns a module and calls its process() directly, without an engine, cables or UI.
+ * Inputs are connected by giving them a channel count and a CV source, all outputs are connected.
+ * Port channel counts are set directly, like the engine does for cables, setChannels() ignores disconnected ports.
+ * With the real-time audit enabled every process() call is audited, violations accumulate until cleared.
+ * Allocated on a cache line like the modules it holds, so heap allocated harnesses keep the modules' layout.
+ */
+template <typename TModule>
+struct ModuleHarness : DANT::CacheAligned {
+  TModule module;
+
+  explicit ModuleHarness(const float sampleRate = 48000.0f) {
+    for (rack::engine::Output& output : this->module.outputs) {
+      output.channels = 1;
+    }
+    setSampleRate(sampleRate);
+  }
+
+  void setSampleRate(const float sampleRate) {
+    this->args.sampleRate = sampleRate;
+    this->args.sampleTime = 1.0f / sampleRate;
+    rack::engine::Module::SampleRateChangeEvent e;
+    e.sampleRate = sampleRate;
+    e.sampleTime = this->args.sampleTime;
+    static_cast<rack::engine::Module&>(this->module).onSampleRateChange(e);  // the event overload, not hidden
+  }
+
+  float getSampleRate() const { return this->args.sampleRate; }
+
+  int64_t getFrame() const { return this->args.frame; }
+
+  double getSeconds() const { return static_cast<double>(this->args.frame) * this->args.sampleTime; }
+
+  void setParam(const int paramId, const float value) { this->module.params[paramId].setValue(value); }
+
+  void connectInput(const int inputId, const int channels, const CvSource& source) {
+    this->module.inputs[inputId].channels = channels;
+    this->sources[inputId] = source;
+  }
+
+  // audits process() for allocations, locks and file I/O, see rt-audit.hpp
+  void setRealtimeAudit(const bool enabled) {
+    this->realtimeAudit = enabled;
+    DANT::RtAudit::clear();
+  }
+
+  uint64_t getRealtimeViolations() const { return DANT::RtAudit::total(); }
+
+  std::string describeRealtimeViolations() const { return DANT::RtAudit::describe(); }
+
+  void disconnectInput(const int inputId) {
+    this->module.inputs[inputId].channels = 0;
+    std::fill(this->module.inputs[inputId].voltages, this->module.inputs[inputId].voltages + DANT::CHANS, 0.0f);
+    this->sources.erase(inputId);
+  }
+
+  // runs one frame, CV sources are evaluated at the frame time before process()
+  void step() {
+    const double seconds{getSeconds()};
+    for (const auto& source : this->sources) {
+      rack::engine::Input& input = this->module.inputs[source.first];
+      for (int c{0}; c < input.getChannels(); ++c) {
+        input.voltages[c] = source.second(seconds, c);
+      }
+    }
+    processFrame();
+  }
+
+  void run(const int numFrames) {
+    for (int i{0}; i < numFrames; ++i) {
+      step();
+    }
+  }
+
+  // runs numFrames frames and returns one output channel, one value per frame
+  std::vector<float> collect(const int outputId, const int channel, const int numFrames) {
+    std::vector<float> collected;
+    collected.reserve(numFrames);
+    for (int i{0}; i < numFrames; ++i) {
+      step();
+      collected.push_back(this->module.outputs[outputId].getVoltage(channel));
+    }
+    return collected;
+  }
+
+  /**
+   * Replays a capture at full speed, each frame sets every param and input before process().
+   * Runs at the capture's sample rate, CV sources are ignored. Returns the number of frames replayed.
+   */
+  int replay(DANT::CaptureDecoder& decoder, const int maxFrames = INT_MAX) {
+    setSampleRate(decoder.getHeader().sampleRate);
+    DANT::CaptureFrame frame;
+    int replayed{0};
+    while (replayed < maxFrames && decoder.next(frame)) {
+      DANT::applyFrame(frame, this->module);
+      processFrame();
+      ++replayed;
+    }
+    return replayed;
+  }
+
+  float getOutput(const int outputId, const int channel = 0) {
+    return this->module.outputs[outputId].getVoltage(channel);
+  }
+
+  int getOutputChannels(const int outputId) { return this->module.outputs[outputId].getChannels(); }
+
+  // bypassed frames call processBypass() in place of process(), like the engine
+  void setBypassed(const bool bypassed) { this->bypassed = bypassed; }
+
+  // places the module directly to the left of another harness's module, or apart from it, like the engine does
+  template <typename TRight>
+  void placeLeftOf(ModuleHarness<TRight>& right, const bool adjacent = true) {
+    this->module.rightExpander.module = adjacent ? &right.module : nullptr;
+    right.module.leftExpander.module = adjacent ? &this->module : nullptr;
+    rack::engine::Module::ExpanderChangeEvent e;
+    e.side = 1;
+    static_cast<rack::engine::Module&>(this->module).onExpanderChange(e);
+    e.side = 0;
+    static_cast<rack::engine::Module&>(right.module).onExpanderChange(e);
+  }
+
+ private:
+  rack::engine::Module::ProcessArgs args{};
+  std::map<int, CvSource> sources;
+  bool realtimeAudit{false};
+  bool bypassed{false};
+
+  void processFrame() {
+    if (this->realtimeAudit) {
+      DANT::RtAudit::Scope audit;
+      process();
+    } else {
+      process();
+    }
+    // the engine flips the expander messages at the end of every frame
+    flipMessages(this->module.leftExpander);
+    flipMessages(this->module.rightExpander);
+    ++this->args.frame;
+  }
+
+  void process() {
+    if (this->bypassed) {
+      this->module.processBypass(this->args);
+    } else {
+      this->module.process(this->args);
+    }
+  }
+
+  static void flipMessages(rack::engine::Module::Expander& expander) {
+    if (expander.messageFlipRequested) {
+      std::swap(expander.producerMessage, expander.consumerMessage);
+      expander.messageFlipRequested = false;
+    }
+  }
+};
+
+}  // namespace DANT
@@ -0,0 +1,48 @@
+#include "../src/dsp/mono-block.hpp"
+
+#include <rack.hpp>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("mono-block.hpp::MonoBlock") {
+  SECTION("Output is the kernel output delayed by the latency") {
+    DANT::MonoBlock monoBlock;
+    monoBlock.setEnabled(true);
+    REQUIRE(monoBlock.isEnabled());
+    REQUIRE(monoBlock.latency() == DANT::MONO_BLOCK_FRAMES);
+
+    const int frames{DANT::MONO_BLOCK_FRAMES};
+    int kernelCalls{0};
+    std::vector<float> outputs;
+    for (int i{0}; i < frames * 3; ++i) {
+      outputs.push_back(monoBlock.process(static_cast<float>(i + 1), [&](const rack::simd::float_4 inputFrames) {
+        ++kernelCalls;
+        // each block is processed on its last frame
+        CHECK(i % frames == frames - 1);
+        CHECK(inputFrames[0] == static_cast<float>(i + 2 - frames));
+        return inputFrames * 2.0f;
+      }));
+    }
+
+    CHECK(kernelCalls == 3);
+    for (int i{0}; i < frames * 3; ++i) {
+      const float expected{i < frames ? 0.0f : static_cast<float>(i + 1 - frames) * 2.0f};
+      UNSCOPED_INFO("sample [" << i << "]");
+      CHECK(outputs[i] == expected);
+    }
+  }
+
+  SECTION("Disabled adds no latency, and enabling clears the buffered signal") {
+    DANT::MonoBlock monoBlock;
+    CHECK_FALSE(monoBlock.isEnabled());
+    CHECK(monoBlock.latency() == 0);
+
+    monoBlock.setEnabled(true);
+    for (int i{0}; i < DANT::MONO_BLOCK_FRAMES; ++i) {
+      monoBlock.process(1.0f, [](const rack::simd::float_4 inputFrames) { return inputFrames; });
+    }
+    monoBlock.setEnabled(true);
+    CHECK(monoBlock.process(1.0f, [](const rack::simd::float_4 inputFrames) { return inputFrames; }) == 0.0f);
+  }
+}
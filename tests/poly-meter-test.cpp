@@ -0,0 +1,74 @@
+#include "../src/dsp/poly-meter.hpp"
+
+#include <rack.hpp>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+const float FP_TOLERANCE_METER = 1e-6f;
+
+static void check_meter_approx_equal(const rack::simd::float_4& actual, const rack::simd::float_4& expected) {
+  for (int i{0}; i < 4; ++i) {
+    Catch::Detail::Approx target = Catch::Detail::Approx(expected[i]).epsilon(FP_TOLERANCE_METER);
+
+    UNSCOPED_INFO("lane [" << i << "]");
+    CHECK(actual[i] == target);
+  }
+}
+
+struct MeterTestCaseParams {
+  std::string name;
+  std::vector<rack::simd::float_4> samples;
+  rack::simd::float_4 expectedPeak;
+  rack::simd::float_4 expectedRms;
+};
+
+TEST_CASE("poly-meter.hpp::PolyMeter") {
+  std::vector<MeterTestCaseParams> testSuite = {
+      {"Constant signals keep their polarity",
+       {rack::simd::float_4(1.0f, -2.0f, 0.0f, 5.0f), rack::simd::float_4(1.0f, -2.0f, 0.0f, 5.0f)},
+       rack::simd::float_4(1.0f, -2.0f, 0.0f, 5.0f),
+       rack::simd::float_4(1.0f, -2.0f, 0.0f, 5.0f)},
+      {"Larger excursion sets the polarity",
+       {rack::simd::float_4(4.0f, -4.0f, 3.0f, -1.0f), rack::simd::float_4(-2.0f, 2.0f, -3.0f, 0.5f)},
+       rack::simd::float_4(4.0f, -4.0f, 3.0f, -1.0f),
+       rack::simd::float_4(3.16227766f, -3.16227766f, 3.0f, -0.79056942f)},
+      {"Empty interval reads zero", {}, rack::simd::float_4(0.0f), rack::simd::float_4(0.0f)},
+  };
+
+  for (const auto& testCase : testSuite) {
+    SECTION(testCase.name) {
+      DANT::PolyMeter meter;
+      for (const auto& sample : testCase.samples) {
+        meter.process(sample, 0);
+      }
+      meter.reduce(static_cast<int>(testCase.samples.size()));
+
+      check_meter_approx_equal(meter.peak[0], testCase.expectedPeak);
+      check_meter_approx_equal(meter.rms[0], testCase.expectedRms);
+    }
+  }
+
+  SECTION("Held peak decays after the signal stops") {
+    DANT::PolyMeter meter;
+    meter.peakDecay = 0.5f;
+    meter.process(rack::simd::float_4(8.0f, -8.0f, 0.0f, 0.0f), 0);
+    meter.reduce(1);
+    meter.reduce(1);
+
+    check_meter_approx_equal(meter.peak[0], rack::simd::float_4(4.0f, -4.0f, 0.0f, 0.0f));
+    check_meter_approx_equal(meter.rms[0], rack::simd::float_4(0.0f));
+  }
+
+  SECTION("Mono frames reduce into channel 0") {
+    DANT::PolyMeter meter;
+    meter.processMonoFrames(rack::simd::float_4(1.0f, -3.0f, 2.0f, 0.0f));
+    meter.processMonoFrames(rack::simd::float_4(0.0f, 1.0f, -1.0f, 2.0f));
+    meter.reduce(8);
+
+    CHECK(meter.peak[0][0] == Catch::Detail::Approx(-3.0f).epsilon(FP_TOLERANCE_METER));
+    CHECK(meter.rms[0][0] == Catch::Detail::Approx(-1.5811388f).epsilon(FP_TOLERANCE_METER));
+    CHECK(meter.peak[0][1] == 0.0f);
+  }
+}
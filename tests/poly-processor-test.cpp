@@ -0,0 +1,89 @@
+#include "../src/dsp/poly-processor.hpp"
+
+#include <rack.hpp>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+// doubles valid lanes and marks masked lanes with -1, so both the kernel output and the mask are visible
+static rack::simd::float_4 doubleValidLanes(const int block, const int c, const rack::simd::float_4 inputs,
+                                            const rack::simd::float_4 validMask) {
+  return rack::simd::ifelse(validMask, inputs * 2.0f, -1.0f);
+}
+
+// setChannels() leaves disconnected ports at 0 channels, so ports are connected by setting the count directly
+static void fill_input(rack::engine::Input& input, const int numChannels) {
+  for (int c{0}; c < DANT::CHANS; ++c) {
+    input.voltages[c] = static_cast<float>(c + 1);
+  }
+  input.channels = numChannels;
+}
+
+static void connect_output(rack::engine::Output& output) { output.channels = 1; }
+
+TEST_CASE("poly-processor.hpp::channelPathFor") {
+  CHECK(DANT::channelPathFor(0) == DANT::NO_CHANS);
+  CHECK(DANT::channelPathFor(1) == DANT::MONO_CHANS);
+  CHECK(DANT::channelPathFor(2) == DANT::QUAD_CHANS);
+  CHECK(DANT::channelPathFor(4) == DANT::QUAD_CHANS);
+  CHECK(DANT::channelPathFor(5) == DANT::OCTO_CHANS);
+  CHECK(DANT::channelPathFor(8) == DANT::OCTO_CHANS);
+  CHECK(DANT::channelPathFor(9) == DANT::TRI_CHANS);
+  CHECK(DANT::channelPathFor(12) == DANT::TRI_CHANS);
+  CHECK(DANT::channelPathFor(13) == DANT::FULL_CHANS);
+  CHECK(DANT::channelPathFor(16) == DANT::FULL_CHANS);
+
+  DANT::ChannelPathSelector selector;
+  CHECK(selector.select(3) == DANT::QUAD_CHANS);
+  CHECK(selector.select(3) == DANT::QUAD_CHANS);
+  CHECK(selector.select(12) == DANT::TRI_CHANS);
+  CHECK(selector.select(16) == DANT::FULL_CHANS);
+}
+
+TEST_CASE("poly-processor.hpp::PolyProcessor") {
+  for (int numChannels{1}; numChannels <= DANT::CHANS; ++numChannels) {
+    SECTION("Specialised path matches the generic loop, " + std::to_string(numChannels) + " channels") {
+      rack::engine::Input input;
+      rack::engine::Output generic;
+      rack::engine::Output specialised;
+      fill_input(input, numChannels);
+      connect_output(generic);
+      connect_output(specialised);
+
+      DANT::PolyProcessor<>::process(input, generic, numChannels, doubleValidLanes);
+      DANT::PolyProcessor<>::process(DANT::channelPathFor(numChannels), input, specialised, numChannels,
+                                     doubleValidLanes);
+
+      REQUIRE(generic.getChannels() == numChannels);
+      REQUIRE(specialised.getChannels() == numChannels);
+      for (int c{0}; c < numChannels; ++c) {
+        UNSCOPED_INFO("channel [" << c << "]");
+        CHECK(generic.voltages[c] == static_cast<float>(c + 1) * 2.0f);
+        CHECK(specialised.voltages[c] == generic.voltages[c]);
+      }
+      // lanes past the channel count, within the last processed block, are masked
+      for (int c{numChannels}; c < ((numChannels + 3) / 4) * 4; ++c) {
+        UNSCOPED_INFO("masked channel [" << c << "]");
+        CHECK(specialised.voltages[c] == -1.0f);
+      }
+      // blocks past the channel count aren't run through the kernel
+      for (int c{((numChannels + 3) / 4) * 4}; c < DANT::CHANS; ++c) {
+        UNSCOPED_INFO("unprocessed channel [" << c << "]");
+        CHECK(specialised.voltages[c] == 0.0f);
+      }
+    }
+  }
+
+  SECTION("Scalar mono path") {
+    rack::engine::Input input;
+    rack::engine::Output output;
+    fill_input(input, 1);
+    connect_output(output);
+
+    DANT::PolyProcessor<>::processMono(input, output, [](const float signal) { return signal * 3.0f; });
+
+    CHECK(output.getChannels() == 1);
+    CHECK(output.voltages[0] == 3.0f);
+  }
+}
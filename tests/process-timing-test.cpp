@@ -0,0 +1,65 @@
+#include "../src/dsp/process-timing.hpp"
+
+#include <cstdint>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("process-timing.hpp::timingBucket") {
+  SECTION("Every duration falls in its bucket's range") {
+    for (uint64_t ticks{0u}; ticks < 100000u; ++ticks) {
+      const int bucket{DANT::timingBucket(ticks)};
+      UNSCOPED_INFO("ticks " << ticks);
+      CHECK(DANT::timingBucketStart(bucket) <= ticks);
+      CHECK(DANT::timingBucketStart(bucket + 1) > ticks);
+    }
+  }
+
+  SECTION("Buckets are exact for small durations, then 4 per octave") {
+    CHECK(DANT::timingBucket(3u) == 3);
+    CHECK(DANT::timingBucket(4u) == 4);
+    CHECK(DANT::timingBucket(8u) == 8);
+    CHECK(DANT::timingBucket(1024u) - DANT::timingBucket(512u) == DANT::TIMING_STEPS);
+  }
+
+  SECTION("Long durations go in the last bucket") {
+    CHECK(DANT::timingBucket(UINT64_MAX) == DANT::TIMING_BUCKETS - 1);
+  }
+}
+
+TEST_CASE("process-timing.hpp::TimingHistogram") {
+  DANT::TimingHistogram histogram;
+
+  SECTION("Empty histogram") {
+    CHECK(histogram.getCalls() == 0u);
+    CHECK(histogram.quantileTicks(0.5) == 0u);
+    CHECK(histogram.getMaxTicks() == 0u);
+  }
+
+  SECTION("Quantiles are the upper bound of their bucket, spikes show in p99 and max") {
+    for (int i{0}; i < 990; ++i) {
+      histogram.record(100u);
+    }
+    for (int i{0}; i < 10; ++i) {
+      histogram.record(5000u);
+    }
+    CHECK(histogram.getCalls() == 1000u);
+    CHECK(histogram.getMaxTicks() == 5000u);
+
+    const uint64_t p50{histogram.quantileTicks(0.5)};
+    CHECK(p50 >= 100u);
+    CHECK(p50 < 128u);
+    CHECK(histogram.quantileTicks(0.99) == p50);
+    CHECK(histogram.quantileTicks(0.999) == 5000u);
+  }
+
+  SECTION("Reset is carried out on the next record") {
+    histogram.record(100u);
+    histogram.record(200u);
+    histogram.requestReset();
+    CHECK(histogram.getCalls() == 2u);
+
+    histogram.record(300u);
+    CHECK(histogram.getCalls() == 1u);
+    CHECK(histogram.getMaxTicks() == 300u);
+  }
+}
@@ -0,0 +1,63 @@
+#include "rt-audit.hpp"
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+TEST_CASE("rt-audit.hpp::RtAudit") {
+  REQUIRE(DANT::RtAudit::isInterposed());
+  DANT::RtAudit::clear();
+
+  SECTION("Allocations and frees are counted inside a scope only") {
+    std::vector<int>* outside{new std::vector<int>(8)};
+    delete outside;
+    CHECK(DANT::RtAudit::total() == 0u);
+
+    {
+      DANT::RtAudit::Scope audit;
+      std::vector<int>* inside{new std::vector<int>(8)};
+      delete inside;
+    }
+    CHECK(DANT::RtAudit::count(DANT::RT_ALLOC) == 2u);
+    CHECK(DANT::RtAudit::count(DANT::RT_FREE) == 2u);
+    CHECK(DANT::RtAudit::describe() == "2 allocation, 2 free");
+  }
+
+  SECTION("Clean code reports nothing") {
+    float sum{0.0f};
+    {
+      DANT::RtAudit::Scope audit;
+      for (int i{0}; i < 64; ++i) {
+        sum += static_cast<float>(i);
+      }
+    }
+    CHECK(sum == 2016.0f);
+    CHECK(DANT::RtAudit::total() == 0u);
+    CHECK(DANT::RtAudit::describe().empty());
+  }
+
+#if defined(__linux__) && defined(__GLIBC__)
+  SECTION("Locks are counted") {
+    std::mutex mutex;
+    {
+      DANT::RtAudit::Scope audit;
+      std::lock_guard<std::mutex> lock(mutex);
+    }
+    CHECK(DANT::RtAudit::count(DANT::RT_LOCK) == 1u);
+  }
+
+  SECTION("File I/O is counted") {
+    std::FILE* file{nullptr};
+    {
+      DANT::RtAudit::Scope audit;
+      file = std::fopen("/dev/null", "r");
+    }
+    REQUIRE(file != nullptr);
+    std::fclose(file);
+    CHECK(DANT::RtAudit::count(DANT::RT_FILE) >= 1u);
+  }
+#endif
+}
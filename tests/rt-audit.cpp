@@ -0,0 +1,208 @@
+#include "rt-audit.hpp"
+
+#include <cstdlib>
+#include <new>
+
+/**
+ * Interposed functions for the real-time safety audit, see rt-audit.hpp.
+ * Definitions in the executable take precedence over the C and C++ runtimes' own, every call reports to the audit
+ * and forwards to the real function.
+ */
+
+static const bool INTERPOSED{DANT::RtAudit::isInterposed() = true};
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+// glibc's allocator entry points, not interposable, so forwarding to them never recurses
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+// the next definition of a symbol after this executable's, resolved on first use
+template <typename F>
+static F next(F& real, const char* name) {
+  if (!real) {
+    real = reinterpret_cast<F>(dlsym(RTLD_NEXT, name));
+  }
+  return real;
+}
+
+extern "C" {
+
+void* malloc(size_t size) {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  *ptr = __libc_memalign(alignment, size);
+  return *ptr ? 0 : ENOMEM;
+}
+
+void free(void* ptr) {
+  if (ptr) {
+    DANT::RtAudit::report(DANT::RT_FREE);
+  }
+  __libc_free(ptr);
+}
+
+int pthread_mutex_lock(pthread_mutex_t* mutex) {
+  static int (*real)(pthread_mutex_t*){nullptr};
+  DANT::RtAudit::report(DANT::RT_LOCK);
+  return next(real, "pthread_mutex_lock")(mutex);
+}
+
+// the optional mode argument of open, only passed with O_CREAT or O_TMPFILE
+#define OPEN_MODE(flags, mode)                     \
+  if ((flags) & (O_CREAT | O_TMPFILE)) {           \
+    va_list args;                                  \
+    va_start(args, flags);                         \
+    mode = static_cast<mode_t>(va_arg(args, int)); \
+    va_end(args);                                  \
+  }
+
+int open(const char* path, int flags, ...) {
+  static int (*real)(const char*, int, ...){nullptr};
+  DANT::RtAudit::report(DANT::RT_FILE);
+  mode_t mode{0};
+  OPEN_MODE(flags, mode);
+  return next(real, "open")(path, flags, mode);
+}
+
+int open64(const char* path, int flags, ...) {
+  static int (*real)(const char*, int, ...){nullptr};
+  DANT::RtAudit::report(DANT::RT_FILE);
+  mode_t mode{0};
+  OPEN_MODE(flags, mode);
+  return next(real, "open64")(path, flags, mode);
+}
+
+ssize_t read(int fd, void* buffer, size_t count) {
+  static ssize_t (*real)(int, void*, size_t){nullptr};
+  DANT::RtAudit::report(DANT::RT_FILE);
+  return next(real, "read")(fd, buffer, count);
+}
+
+ssize_t write(int fd, const void* buffer, size_t count) {
+  static ssize_t (*real)(int, const void*, size_t){nullptr};
+  DANT::RtAudit::report(DANT::RT_FILE);
+  return next(real, "write")(fd, buffer, count);
+}
+
+int close(int fd) {
+  static int (*real)(int){nullptr};
+  DANT::RtAudit::report(DANT::RT_FILE);
+  return next(real, "close")(fd);
+}
+
+FILE* fopen(const char* path, const char* mode) {
+  static FILE* (*real)(const char*, const char*){nullptr};
+  DANT::RtAudit::report(DANT::RT_FILE);
+  return next(real, "fopen")(path, mode);
+}
+
+size_t fread(void* buffer, size_t size, size_t count, FILE* file) {
+  static size_t (*real)(void*, size_t, size_t, FILE*){nullptr};
+  DANT::RtAudit::report(DANT::RT_FILE);
+  return next(real, "fread")(buffer, size, count, file);
+}
+
+size_t fwrite(const void* buffer, size_t size, size_t count, FILE* file) {
+  static size_t (*real)(const void*, size_t, size_t, FILE*){nullptr};
+  DANT::RtAudit::report(DANT::RT_FILE);
+  return next(real, "fwrite")(buffer, size, count, file);
+}
+
+int fclose(FILE* file) {
+  static int (*real)(FILE*){nullptr};
+  DANT::RtAudit::report(DANT::RT_FILE);
+  return next(real, "fclose")(file);
+}
+
+}  // extern "C"
+
+#else
+
+// without glibc only C++ allocations are audited, through the replaceable global operator new and delete
+
+void* operator new(std::size_t size) {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  void* ptr{std::malloc(size > 0u ? size : 1u)};
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size) {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  void* ptr{std::malloc(size > 0u ? size : 1u)};
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  return std::malloc(size > 0u ? size : 1u);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  DANT::RtAudit::report(DANT::RT_ALLOC);
+  return std::malloc(size > 0u ? size : 1u);
+}
+
+void operator delete(void* ptr) noexcept {
+  if (ptr) {
+    DANT::RtAudit::report(DANT::RT_FREE);
+  }
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  if (ptr) {
+    DANT::RtAudit::report(DANT::RT_FREE);
+  }
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { ::operator delete(ptr); }
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { ::operator delete[](ptr); }
+
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace DANT {
+
+enum RT_VIOLATION { RT_ALLOC, RT_FREE, RT_LOCK, RT_FILE, NUM_RT_VIOLATIONS };
+static const char* const RT_VIOLATION_NAMES[NUM_RT_VIOLATIONS]{"allocation", "free", "mutex lock", "file I/O"};
+
+/**
+ * Real-time safety audit, counts calls that must never happen on the audio thread while a Scope is armed.
+ * The calls are intercepted by rt-audit.cpp, which is linked into the test runner:
+ * with glibc malloc/free and friends, pthread_mutex_lock and file open/read/write/close calls are interposed,
+ * on other platforms only the global operator new and delete are replaced.
+ * Counts are per thread, so only the thread running the audited code is checked.
+ */
+struct RtAudit {
+  struct State {
+    bool armed{false};
+    uint64_t counts[NUM_RT_VIOLATIONS]{};
+  };
+
+  static State& state() {
+    static thread_local State threadState;
+    return threadState;
+  }
+
+  // true when rt-audit.cpp is linked in, otherwise nothing is intercepted and every count stays 0
+  static bool& isInterposed() {
+    static bool interposed{false};
+    return interposed;
+  }
+
+  // called by the interposed functions, must not allocate
+  static void report(const RT_VIOLATION violation) {
+    State& threadState = state();
+    if (threadState.armed) {
+      ++threadState.counts[violation];
+    }
+  }
+
+  static uint64_t count(const RT_VIOLATION violation) { return state().counts[violation]; }
+
+  static uint64_t total() {
+    uint64_t sum{0u};
+    for (int v{0}; v < NUM_RT_VIOLATIONS; ++v) {
+      sum += state().counts[v];
+    }
+    return sum;
+  }
+
+  static void clear() {
+    for (int v{0}; v < NUM_RT_VIOLATIONS; ++v) {
+      state().counts[v] = 0u;
+    }
+  }
+
+  // e.g. "2 allocation, 2 free", empty when there were no violations
+  static std::string describe() {
+    std::string description;
+    for (int v{0}; v < NUM_RT_VIOLATIONS; ++v) {
+      if (state().counts[v] > 0u) {
+        description += (description.empty() ? "" : ", ") + std::to_string(state().counts[v]) + " " +
+                       RT_VIOLATION_NAMES[v];
+      }
+    }
+    return description;
+  }
+
+  // audits the calling thread for the lifetime of the scope
+  struct Scope {
+    Scope() { state().armed = true; }
+    ~Scope() { state().armed = false; }
+  };
+};
+
+}  // namespace DANT
@@ -0,0 +1,85 @@
+#include "../src/shared/triple-buffer.hpp"
+
+#include <atomic>
+#include <rack.hpp>
+#include <thread>
+
+#include "catch2/catch.hpp"
+
+namespace {
+
+// every field holds the same value, so a torn read shows as a mismatch
+struct Settings {
+  int values[8]{};
+
+  explicit Settings(const int value = 0) {
+    for (int& v : values) {
+      v = value;
+    }
+  }
+
+  bool isConsistent() const {
+    for (const int v : values) {
+      if (v != values[0]) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("triple-buffer.hpp::TripleBuffer") {
+  SECTION("The reader takes the latest value once") {
+    DANT::TripleBuffer<Settings> buffer;
+    CHECK_FALSE(buffer.update());
+    CHECK(buffer.read().values[0] == 0);
+
+    buffer.write(Settings(1));
+    CHECK(buffer.latest().values[0] == 1);
+    CHECK(buffer.read().values[0] == 0);  // not taken yet
+    CHECK(buffer.update());
+    CHECK(buffer.read().values[0] == 1);
+    CHECK_FALSE(buffer.update());
+    CHECK(buffer.read().values[0] == 1);
+  }
+
+  SECTION("Values written between updates are skipped, the latest is taken") {
+    DANT::TripleBuffer<Settings> buffer;
+    for (int value{1}; value <= 5; ++value) {
+      buffer.write(Settings(value));
+    }
+    CHECK(buffer.update());
+    CHECK(buffer.read().values[0] == 5);
+    CHECK_FALSE(buffer.update());
+  }
+
+  SECTION("Concurrent reads are never torn and never go backwards") {
+    DANT::TripleBuffer<Settings> buffer;
+    const int numWrites{200000};
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+      for (int value{1}; value <= numWrites; ++value) {
+        buffer.write(Settings(value));
+      }
+      done.store(true);
+    });
+
+    int torn{0};
+    int backwards{0};
+    int previous{0};
+    while (!done.load() || buffer.update()) {
+      buffer.update();
+      const Settings& read = buffer.read();
+      torn += read.isConsistent() ? 0 : 1;
+      backwards += read.values[0] < previous ? 1 : 0;
+      previous = read.values[0];
+    }
+    writer.join();
+    CHECK(torn == 0);
+    CHECK(backwards == 0);
+    buffer.update();
+    CHECK(buffer.read().values[0] == numWrites);
+  }
+}